@@ -0,0 +1,124 @@
+#define DEQUE_BENCHMARK_COUNT_ALLOCATIONS  //every call to the global operator new is counted,so the benchmark shows how many heap allocations each workload makes
+#include"../Deque/Deque.h"
+#include"../Deque/BlockPool.h"
+#include"BenchmarkUtils.h"
+#include<deque>
+
+//keeps the queue at a fixed depth and pushes at the back while popping at the front,so the head and the tail keep crossing block boundaries
+template<typename Container>
+void benchmarkSteadyFifo(const std::string& name, std::size_t depth, std::size_t operations)
+{
+	Container container;
+	for (std::size_t i = 0; i < depth; i++)
+		container.push_back(static_cast<int>(i));
+	for (std::size_t i = 0; i < operations / 10; i++)  //a warm-up phase lets the containers reach their steady state,including the size of the block directory
+	{
+		container.push_back(static_cast<int>(i));
+		container.pop_front();
+	}
+
+	std::size_t allocationsBefore = allocationCount;
+	Timer timer;
+	for (std::size_t i = 0; i < operations; i++)
+	{
+		container.push_back(static_cast<int>(i));
+		container.pop_front();
+	}
+	double seconds = timer.seconds();
+	std::size_t allocations = allocationCount - allocationsBefore;
+
+	printResult(name + " steady FIFO", static_cast<double>(operations), seconds);
+	std::cout << "  heap allocations during the steady phase: " << allocations << std::endl;
+}
+
+//pushes and pops at the back around a block boundary
+template<typename Container>
+void benchmarkBoundaryLifo(const std::string& name, std::size_t operations)
+{
+	Container container;
+	for (std::size_t i = 0; i < 512; i++)
+		container.push_back(static_cast<int>(i));
+	container.push_back(0);  //the first crossing of the boundary is the only one that has to allocate
+	container.pop_back();
+
+	std::size_t allocationsBefore = allocationCount;
+	Timer timer;
+	for (std::size_t i = 0; i < operations; i++)
+	{
+		container.push_back(static_cast<int>(i));
+		container.push_back(static_cast<int>(i));
+		container.pop_back();
+		container.pop_back();
+	}
+	double seconds = timer.seconds();
+	std::size_t allocations = allocationCount - allocationsBefore;
+
+	printResult(name + " boundary LIFO", static_cast<double>(operations) * 4, seconds);
+	std::cout << "  heap allocations during the steady phase: " << allocations << std::endl;
+}
+
+//fills the queue with a burst and drains it again,like an ingest queue between batches.warmUp gets the empty container before the first burst,so a deque can reserve its blocks there
+template<typename Container, typename WarmUp>
+void benchmarkBursts(const std::string& name, std::size_t burstSize, std::size_t bursts, WarmUp warmUp)
+{
+	Container container;
+	warmUp(container);
+
+	std::size_t allocationsBefore = allocationCount;
+	Timer timer;
+	for (std::size_t i = 0; i < bursts; i++)
+	{
+		for (std::size_t j = 0; j < burstSize; j++)
+			container.push_back(static_cast<int>(j));
+		while (!container.empty())
+			container.pop_front();
+	}
+	double seconds = timer.seconds();
+	std::size_t allocations = allocationCount - allocationsBefore;
+
+	printResult(name + " bursts", static_cast<double>(burstSize * bursts), seconds);
+	std::cout << "  heap allocations during the bursts: " << allocations << std::endl;
+}
+
+//creates many short-lived deques,which is where the shared thread-local pool helps
+template<typename Container>
+void benchmarkShortLived(const std::string& name, std::size_t deques)
+{
+	std::size_t allocationsBefore = allocationCount;
+	Timer timer;
+	for (std::size_t i = 0; i < deques; i++)
+	{
+		Container container;
+		for (int j = 0; j < 200; j++)
+			container.push_back(j);
+		doNotOptimize(container.back());
+	}
+	double seconds = timer.seconds();
+	std::size_t allocations = allocationCount - allocationsBefore;
+
+	printResult(name + " short-lived deques", static_cast<double>(deques), seconds);
+	std::cout << "  heap allocations: " << allocations << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t operations = argc > 1 ? std::stoull(argv[1]) : 10000000;
+
+	benchmarkSteadyFifo<std::deque<int>>("std::deque", 1000, operations);
+	benchmarkSteadyFifo<Deque<int>>("Deque", 1000, operations);
+	benchmarkSteadyFifo<Deque<int, 512, PoolAllocator<int>>>("Deque+PoolAllocator", 1000, operations);
+
+	benchmarkBoundaryLifo<std::deque<int>>("std::deque", operations / 4);
+	benchmarkBoundaryLifo<Deque<int>>("Deque", operations / 4);
+
+	std::size_t burstSize = 100000;
+	benchmarkBursts<std::deque<int>>("std::deque", burstSize, operations / burstSize, [](std::deque<int>&) {});
+	benchmarkBursts<Deque<int>>("Deque", burstSize, operations / burstSize, [](Deque<int>&) {});
+	benchmarkBursts<Deque<int>>("Deque+reserve_back", burstSize, operations / burstSize, [burstSize](Deque<int>& deque) { deque.reserve_back(burstSize); });
+
+	benchmarkShortLived<std::deque<int>>("std::deque", operations / 100);
+	benchmarkShortLived<Deque<int>>("Deque", operations / 100);
+	benchmarkShortLived<Deque<int, 512, PoolAllocator<int>>>("Deque+PoolAllocator", operations / 100);
+
+	return 0;
+}
@@ -0,0 +1,76 @@
+#include"../Deque/Deque.h"
+#include"BenchmarkUtils.h"
+#include<cstdint>
+#include<numeric>
+#include<span>
+#include<vector>
+
+//a consumer takes the elements from the front of a deque in batches,with a front and pop_front loop and with pop_front_n,drain_front and consume_front
+//usage: BatchConsumeBenchmark [elementCount]
+
+Deque<std::uint64_t> filledDeque(std::size_t elementCount)
+{
+	Deque<std::uint64_t> deque;
+	for (std::size_t i = 0; i < elementCount; i++)
+		deque.push_back(i);
+	return deque;
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t elementCount = argc > 1 ? std::stoull(argv[1]) : 50000000;
+	double operations = static_cast<double>(elementCount);
+
+	for (std::size_t batchSize : { 256, 1024, 4096 })
+	{
+		std::string suffix = " batch " + std::to_string(batchSize);
+		std::vector<std::uint64_t> buffer(batchSize);
+
+		{
+			Deque<std::uint64_t> deque = filledDeque(elementCount);
+			Timer timer;
+			while (!deque.empty())
+			{
+				std::size_t count = 0;
+				for (; count < batchSize && !deque.empty(); count++)
+				{
+					buffer[count] = deque.front();
+					deque.pop_front();
+				}
+				doNotOptimize(buffer[count - 1]);
+			}
+			printResult("front and pop_front loop" + suffix, operations, timer.seconds());
+		}
+
+		{
+			Deque<std::uint64_t> deque = filledDeque(elementCount);
+			Timer timer;
+			while (!deque.empty())
+			{
+				std::uint64_t* end = deque.drain_front(buffer.data(), batchSize);
+				doNotOptimize(*(end - 1));
+			}
+			printResult("drain_front" + suffix, operations, timer.seconds());
+		}
+
+		{
+			Deque<std::uint64_t> deque = filledDeque(elementCount);
+			Timer timer;
+			std::uint64_t sum = 0;
+			while (!deque.empty())
+				deque.consume_front(batchSize, [&sum](std::span<std::uint64_t> segment) { sum = std::accumulate(segment.begin(), segment.end(), sum); });
+			doNotOptimize(sum);
+			printResult("consume_front" + suffix, operations, timer.seconds());
+		}
+
+		{
+			Deque<std::uint64_t> deque = filledDeque(elementCount);
+			Timer timer;
+			while (!deque.empty())
+				deque.pop_front_n(batchSize);
+			printResult("pop_front_n" + suffix, operations, timer.seconds());
+		}
+	}
+
+	return 0;
+}
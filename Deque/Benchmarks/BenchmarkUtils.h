@@ -0,0 +1,121 @@
+#pragma once
+#include<chrono>
+#include<cstdint>
+#include<iostream>
+#include<string>
+#include<thread>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include<intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include<x86intrin.h>
+#endif
+
+class Timer
+{
+	std::chrono::steady_clock::time_point start;
+
+public:
+	Timer() : start(std::chrono::steady_clock::now()) {}
+
+	double seconds() const
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+};
+
+//the time stamp counter of the processor,or 0 where there is none.It ticks at a constant rate,so it is turned into cycles with the rate cyclesPerNanosecond measures
+inline std::uint64_t readCycleCounter()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+inline double cyclesPerNanosecond()
+{
+	static const double rate = []
+	{
+		std::uint64_t startCycles = readCycleCounter();
+		Timer timer;
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		return static_cast<double>(readCycleCounter() - startCycles) / (timer.seconds() * 1e9);
+	}();
+	return rate;
+}
+
+//keeps the compiler from optimizing away a value that is computed only to be measured
+template<typename T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const T* sink;
+	sink = &value;
+#endif
+}
+
+inline void printResult(const std::string& name, double operations, double seconds)
+{
+	std::cout << name << ": " << operations / seconds / 1e6 << " Mops/s (" << seconds * 1e9 / operations << " ns/op)" << std::endl;
+}
+
+//a benchmark that defines DEQUE_BENCHMARK_COUNT_ALLOCATIONS before it includes this header replaces the global operator new,aligned or not,with one that counts every call in allocationCount
+#ifdef DEQUE_BENCHMARK_COUNT_ALLOCATIONS
+#include<cstdlib>
+#include<new>
+
+static std::size_t allocationCount = 0;
+
+void* operator new(std::size_t bytes)
+{
+	allocationCount++;
+	if (void* pointer = std::malloc(bytes ? bytes : 1))
+		return pointer;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+//the blocks of a deque are over-aligned,so they come from these overloads
+void* operator new(std::size_t bytes, std::align_val_t alignment)
+{
+	allocationCount++;
+	std::size_t alignmentBytes = static_cast<std::size_t>(alignment);
+	std::size_t roundedBytes = (bytes + alignmentBytes - 1) / alignmentBytes * alignmentBytes;  //aligned_alloc wants a multiple of the alignment
+#ifdef _MSC_VER
+	if (void* pointer = _aligned_malloc(roundedBytes ? roundedBytes : alignmentBytes, alignmentBytes))
+		return pointer;
+#else
+	if (void* pointer = std::aligned_alloc(alignmentBytes, roundedBytes ? roundedBytes : alignmentBytes))
+		return pointer;
+#endif
+	throw std::bad_alloc();
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+#ifdef _MSC_VER
+	_aligned_free(pointer);
+#else
+	std::free(pointer);
+#endif
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t alignment) noexcept
+{
+	operator delete(pointer, alignment);
+}
+#endif
@@ -0,0 +1,51 @@
+#include"../Deque/Deque.h"
+#include"BenchmarkUtils.h"
+
+struct Payload64
+{
+	long long values[8];
+};
+
+//runs push_back,pop_front and a full iteration on a deque with the given block size in bytes
+template<typename T, std::size_t BlockBytes>
+void benchmarkBlockSize(const std::string& typeName, std::size_t elementCount)
+{
+	std::string name = typeName + " BlockBytes=" + std::to_string(BlockBytes);
+	Deque<T, BlockBytes> deque;
+
+	Timer pushTimer;
+	for (std::size_t i = 0; i < elementCount; i++)
+		deque.push_back(T{});
+	printResult(name + " push_back", static_cast<double>(elementCount), pushTimer.seconds());
+
+	Timer iterationTimer;
+	std::size_t visited = 0;
+	for (auto it = deque.begin(); it != deque.end(); ++it)
+	{
+		doNotOptimize(*it);
+		visited++;
+	}
+	printResult(name + " iteration", static_cast<double>(visited), iterationTimer.seconds());
+
+	Timer popTimer;
+	for (std::size_t i = 0; i < elementCount; i++)
+		deque.pop_front();
+	printResult(name + " pop_front", static_cast<double>(elementCount), popTimer.seconds());
+}
+
+template<typename T, std::size_t... BlockBytes>
+void sweepBlockSizes(const std::string& typeName, std::size_t elementCount)
+{
+	(benchmarkBlockSize<T, BlockBytes>(typeName, elementCount), ...);
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t elementCount = argc > 1 ? std::stoull(argv[1]) : 10000000;
+
+	sweepBlockSizes<char, 64, 256, 512, 1024, 4096, 16384>("char", elementCount);
+	sweepBlockSizes<int, 64, 256, 512, 1024, 4096, 16384>("int", elementCount);
+	sweepBlockSizes<Payload64, 64, 256, 512, 1024, 4096, 16384>("Payload64", elementCount / 4);
+
+	return 0;
+}
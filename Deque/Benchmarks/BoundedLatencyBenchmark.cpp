@@ -0,0 +1,85 @@
+#define DEQUE_BENCHMARK_COUNT_ALLOCATIONS  //every call to the global operator new is counted,so the benchmark shows if the steady state touches the heap
+#include"../Deque/BoundedDeque.h"
+#include"../Deque/Deque.h"
+#include"BenchmarkUtils.h"
+#include<algorithm>
+#include<chrono>
+#include<deque>
+#include<vector>
+
+struct Quote
+{
+	long long timestamp;
+	double bid;
+	double ask;
+	int bidSize;
+	int askSize;
+};
+
+void printPercentiles(const std::string& name, std::vector<double>& latencies)
+{
+	std::sort(latencies.begin(), latencies.end());
+	auto percentile = [&latencies](double fraction) { return latencies[static_cast<std::size_t>(fraction * (latencies.size() - 1))]; };
+	std::cout << name << ": p50 " << percentile(0.5) << " ns, p99 " << percentile(0.99) << " ns, p99.9 " << percentile(0.999) << " ns, max " << latencies.back() << " ns" << std::endl;
+}
+
+//keeps the queue at a fixed depth and times every push_back and every pop_front on its own.The latencies include the cost of reading the clock,which is printed first
+template<typename Container>
+void benchmarkLatency(const std::string& name, Container& container, std::size_t depth, std::size_t operations)
+{
+	for (std::size_t i = 0; i < depth; i++)
+		container.push_back(Quote{});
+	for (std::size_t i = 0; i < operations / 10; i++)  //warm-up
+	{
+		container.push_back(Quote{});
+		container.pop_front();
+	}
+
+	std::vector<double> pushLatencies(operations);
+	std::vector<double> popLatencies(operations);
+	std::size_t allocationsBefore = allocationCount;
+	for (std::size_t i = 0; i < operations; i++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		container.push_back(Quote{ static_cast<long long>(i), 1.0, 1.0, 1, 1 });
+		auto pushed = std::chrono::steady_clock::now();
+		container.pop_front();
+		auto popped = std::chrono::steady_clock::now();
+		pushLatencies[i] = std::chrono::duration<double, std::nano>(pushed - start).count();
+		popLatencies[i] = std::chrono::duration<double, std::nano>(popped - pushed).count();
+	}
+	std::size_t allocations = allocationCount - allocationsBefore;
+
+	printPercentiles(name + " push_back", pushLatencies);
+	printPercentiles(name + " pop_front", popLatencies);
+	std::cout << "  heap allocations during the steady phase: " << allocations << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t depth = argc > 1 ? std::stoull(argv[1]) : 1000;
+	std::size_t operations = argc > 2 ? std::stoull(argv[2]) : 2000000;
+
+	std::vector<double> clockLatencies(operations);
+	for (std::size_t i = 0; i < operations; i++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		auto end = std::chrono::steady_clock::now();
+		clockLatencies[i] = std::chrono::duration<double, std::nano>(end - start).count();
+	}
+	printPercentiles("clock overhead", clockLatencies);
+
+	BoundedDeque<Quote> bounded(depth + 1);
+	benchmarkLatency("BoundedDeque", bounded, depth, operations);
+
+	BoundedDeque<Quote, BoundedPolicy::Overwrite> overwriting(depth + 1);
+	benchmarkLatency("BoundedDeque Overwrite", overwriting, depth, operations);
+
+	Deque<Quote> deque;
+	benchmarkLatency("Deque", deque, depth, operations);
+
+	std::deque<Quote> standardDeque;
+	benchmarkLatency("std::deque", standardDeque, depth, operations);
+
+	return 0;
+}
@@ -0,0 +1,83 @@
+#include"../Deque/Deque.h"
+#include"BenchmarkUtils.h"
+#include<cstring>
+#include<deque>
+#include<vector>
+
+struct Tick
+{
+	long long timestamp;
+	double price;
+	double quantity;
+	long long orderId;
+	int venue;
+	int flags;
+	long long sequence;
+	double reserved[2];
+};
+
+//loads the same batch into a container again and again,the time of a plain memcpy of the payload into memory that is already allocated is the lower bound
+template<typename Function>
+void benchmarkLoad(const std::string& name, std::size_t batchSize, std::size_t repetitions, Function load)
+{
+	Timer timer;
+	for (std::size_t i = 0; i < repetitions; i++)
+		load();
+	printResult(name, static_cast<double>(batchSize * repetitions), timer.seconds());
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t batchSize = argc > 1 ? std::stoull(argv[1]) : 100000;
+	std::size_t repetitions = argc > 2 ? std::stoull(argv[2]) : 200;
+
+	std::vector<Tick> batch(batchSize);
+	for (std::size_t i = 0; i < batchSize; i++)
+		batch[i].sequence = static_cast<long long>(i);
+
+	std::vector<Tick> target(batchSize);
+	benchmarkLoad("memcpy", batchSize, repetitions, [&]()
+	{
+		std::memcpy(target.data(), batch.data(), batchSize * sizeof(Tick));
+		doNotOptimize(target.back());
+	});
+
+	benchmarkLoad("Deque push_back", batchSize, repetitions, [&]()
+	{
+		Deque<Tick> deque;
+		for (const Tick& tick : batch)
+			deque.push_back(tick);
+		doNotOptimize(deque.back());
+	});
+
+	benchmarkLoad("Deque append", batchSize, repetitions, [&]()
+	{
+		Deque<Tick> deque;
+		deque.append(batch.begin(), batch.end());
+		doNotOptimize(deque.back());
+	});
+
+	benchmarkLoad("Deque prepend", batchSize, repetitions, [&]()
+	{
+		Deque<Tick> deque;
+		deque.push_back(Tick{});
+		deque.prepend(batch.begin(), batch.end());
+		doNotOptimize(deque.front());
+	});
+
+	Deque<Tick> reused;  //assign refills the blocks of the previous batch,so after the first repetition it doesn't allocate
+	benchmarkLoad("Deque assign", batchSize, repetitions, [&]()
+	{
+		reused.assign(batch.begin(), batch.end());
+		doNotOptimize(reused.back());
+	});
+
+	benchmarkLoad("std::deque insert", batchSize, repetitions, [&]()
+	{
+		std::deque<Tick> deque;
+		deque.insert(deque.end(), batch.begin(), batch.end());
+		doNotOptimize(deque.back());
+	});
+
+	return 0;
+}
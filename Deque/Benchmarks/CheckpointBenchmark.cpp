@@ -0,0 +1,83 @@
+#include"../Deque/Deque.h"
+#include"BenchmarkUtils.h"
+#include<filesystem>
+#include<fstream>
+#include<string>
+#include<vector>
+
+//saves a queue to a file and loads it back the way a service checkpoints its queue on shutdown and reloads it on start.save and load write and read one block range at a time,the element by element version is what a checkpoint cost with the iterator and push_back
+void benchmarkCheckpoint(const std::filesystem::path& path, std::size_t elementCount)
+{
+	Deque<int> deque;
+	for (std::size_t i = 0; i < elementCount; i++)
+		deque.push_back(static_cast<int>(i));
+	double bytes = static_cast<double>(elementCount * sizeof(int));
+
+	Timer saveTimer;
+	{
+		std::ofstream output(path, std::ios::binary);
+		deque.save(output);
+	}
+	double saveSeconds = saveTimer.seconds();
+	printResult("Deque::save", static_cast<double>(elementCount), saveSeconds);
+	std::cout << "  " << bytes / saveSeconds / 1e6 << " MB/s" << std::endl;
+
+	Timer loadTimer;
+	Deque<int> loaded;
+	{
+		std::ifstream input(path, std::ios::binary);
+		loaded.load(input);
+	}
+	double loadSeconds = loadTimer.seconds();
+	printResult("Deque::load", static_cast<double>(elementCount), loadSeconds);
+	std::cout << "  " << bytes / loadSeconds / 1e6 << " MB/s" << std::endl;
+	doNotOptimize(loaded.back());
+
+	Timer elementSaveTimer;
+	{
+		std::ofstream output(path, std::ios::binary);
+		for (auto it = deque.cbegin(); it != deque.cend(); ++it)
+			output.write(reinterpret_cast<const char*>(&*it), sizeof(int));
+	}
+	printResult("element by element save", static_cast<double>(elementCount), elementSaveTimer.seconds());
+
+	Timer elementLoadTimer;
+	Deque<int> pushed;
+	{
+		std::ifstream input(path, std::ios::binary);
+		int value;
+		while (input.read(reinterpret_cast<char*>(&value), sizeof(value)))
+			pushed.push_back(value);
+	}
+	printResult("element by element load", static_cast<double>(elementCount), elementLoadTimer.seconds());
+	doNotOptimize(pushed.back());
+
+	//the same bytes written and read in one call,the speed of the disk and the page cache without the deque
+	std::vector<int> buffer(elementCount);
+	Timer rawWriteTimer;
+	{
+		std::ofstream output(path, std::ios::binary);
+		output.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(bytes));
+	}
+	std::cout << "plain write: " << bytes / rawWriteTimer.seconds() / 1e6 << " MB/s" << std::endl;
+
+	Timer rawReadTimer;
+	{
+		std::ifstream input(path, std::ios::binary);
+		input.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(bytes));
+	}
+	std::cout << "plain read: " << bytes / rawReadTimer.seconds() / 1e6 << " MB/s" << std::endl;
+	doNotOptimize(buffer.back());
+
+	std::filesystem::remove(path);
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t elementCount = argc > 1 ? std::stoull(argv[1]) : 50000000;
+	std::filesystem::path path = argc > 2 ? std::filesystem::path(argv[2]) : std::filesystem::temp_directory_path() / "deque_checkpoint.bin";
+
+	benchmarkCheckpoint(path, elementCount);
+
+	return 0;
+}
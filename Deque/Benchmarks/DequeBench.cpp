@@ -0,0 +1,410 @@
+#include"../Deque/Deque.h"
+#include"../Deque/BoundedDeque.h"
+#include"BenchmarkUtils.h"
+#include<algorithm>
+#include<cstdint>
+#include<deque>
+#include<fstream>
+#include<functional>
+#include<random>
+#include<sstream>
+#include<string>
+#include<type_traits>
+#include<vector>
+
+//runs the same workloads over Deque,std::deque,std::vector and BoundedDeque as a ring buffer for several element types and sizes,and writes the results as JSON so they can be compared between commits.
+//usage: deque_bench [--sizes 1000,100000,1000000] [--types int,pod64,string] [--min-ops 1000000] [--commit <id>] [--output results.json]
+
+struct Pod64
+{
+	std::uint64_t values[8];
+};
+
+template<typename T>
+T makeValue(std::size_t i)
+{
+	if constexpr (std::is_same_v<T, std::string>)
+		return std::to_string(i);
+	else if constexpr (std::is_same_v<T, Pod64>)
+		return Pod64{ { i, i + 1, i + 2, i + 3, i + 4, i + 5, i + 6, i + 7 } };
+	else
+		return static_cast<T>(i);
+}
+
+//a cheap value out of an element,so the compiler can't drop the reads
+template<typename T>
+std::uint64_t touch(const T& value)
+{
+	if constexpr (std::is_same_v<T, std::string>)
+		return value.size();
+	else if constexpr (std::is_same_v<T, Pod64>)
+		return value.values[0];
+	else
+		return static_cast<std::uint64_t>(value);
+}
+
+//what a benchmark needs to know about a container that the containers don't have in common
+template<typename Container>
+struct ContainerTraits
+{
+	static constexpr bool hasFront = true;
+	static constexpr bool hasMiddle = true;
+
+	static Container create(std::size_t) { return Container(); }
+};
+
+template<typename T>
+struct ContainerTraits<std::vector<T>>
+{
+	static constexpr bool hasFront = false;
+	static constexpr bool hasMiddle = true;
+
+	static std::vector<T> create(std::size_t) { return std::vector<T>(); }
+};
+
+template<typename T>
+struct ContainerTraits<BoundedDeque<T>>
+{
+	static constexpr bool hasFront = true;
+	static constexpr bool hasMiddle = false;
+
+	static BoundedDeque<T> create(std::size_t capacity) { return BoundedDeque<T>(capacity + 64); }  //the ring has to hold the whole workload
+};
+
+template<typename Container>
+void insertMiddle(Container& container, std::size_t index, const typename Container::value_type& value)
+{
+	if constexpr (requires { container.remove(index); })
+		container.insert(value, index);
+	else
+		container.insert(container.begin() + index, value);
+}
+
+template<typename Container>
+void removeMiddle(Container& container, std::size_t index)
+{
+	if constexpr (requires { container.remove(index); })
+		container.remove(index);
+	else
+		container.erase(container.begin() + index);
+}
+
+template<typename Container>
+Container filledContainer(std::size_t size)
+{
+	Container container = ContainerTraits<Container>::create(size);
+	for (std::size_t i = 0; i < size; i++)
+		container.push_back(makeValue<typename Container::value_type>(i));
+	return container;
+}
+
+struct Measurement
+{
+	double operations;
+	double seconds;
+};
+
+struct Result
+{
+	std::string benchmark;
+	std::string container;
+	std::string type;
+	std::size_t size;
+	Measurement measurement;
+};
+
+//a workload sets up its container outside of the timed part and returns the number of operations it timed
+using Workload = std::function<Measurement(std::size_t size)>;
+
+template<typename Container>
+std::vector<std::pair<std::string, Workload>> workloads()
+{
+	using T = typename Container::value_type;
+	using Traits = ContainerTraits<Container>;
+	std::vector<std::pair<std::string, Workload>> result;
+
+	result.emplace_back("push_back", [](std::size_t size)
+	{
+		Container container = Traits::create(size);
+		Timer timer;
+		for (std::size_t i = 0; i < size; i++)
+			container.push_back(makeValue<T>(i));
+		double seconds = timer.seconds();
+		doNotOptimize(container.back());
+		return Measurement{ static_cast<double>(size), seconds };
+	});
+
+	result.emplace_back("pop_back", [](std::size_t size)
+	{
+		Container container = filledContainer<Container>(size);
+		Timer timer;
+		for (std::size_t i = 0; i < size; i++)
+			container.pop_back();
+		return Measurement{ static_cast<double>(size), timer.seconds() };
+	});
+
+	if constexpr (Traits::hasFront)
+	{
+		result.emplace_back("push_front", [](std::size_t size)
+		{
+			Container container = Traits::create(size);
+			Timer timer;
+			for (std::size_t i = 0; i < size; i++)
+				container.push_front(makeValue<T>(i));
+			double seconds = timer.seconds();
+			doNotOptimize(container.front());
+			return Measurement{ static_cast<double>(size), seconds };
+		});
+
+		result.emplace_back("pop_front", [](std::size_t size)
+		{
+			Container container = filledContainer<Container>(size);
+			Timer timer;
+			for (std::size_t i = 0; i < size; i++)
+				container.pop_front();
+			return Measurement{ static_cast<double>(size), timer.seconds() };
+		});
+
+		//a queue at a fixed depth,every operation is one push_back and one pop_front
+		result.emplace_back("fifo", [](std::size_t size)
+		{
+			Container container = filledContainer<Container>(size);
+			Timer timer;
+			for (std::size_t i = 0; i < size; i++)
+			{
+				container.push_back(makeValue<T>(i));
+				container.pop_front();
+			}
+			double seconds = timer.seconds();
+			doNotOptimize(container.front());
+			return Measurement{ static_cast<double>(size), seconds };
+		});
+	}
+
+	//a stack at a fixed depth that grows and shrinks by a burst of 64 elements,every operation is one push_back or one pop_back
+	result.emplace_back("lifo", [](std::size_t size)
+	{
+		constexpr std::size_t burst = 64;
+		Container container = filledContainer<Container>(size);
+		std::size_t rounds = (size + burst - 1) / burst;
+		Timer timer;
+		for (std::size_t i = 0; i < rounds; i++)
+		{
+			for (std::size_t j = 0; j < burst; j++)
+				container.push_back(makeValue<T>(j));
+			for (std::size_t j = 0; j < burst; j++)
+				container.pop_back();
+		}
+		double seconds = timer.seconds();
+		doNotOptimize(container.back());
+		return Measurement{ static_cast<double>(rounds * burst * 2), seconds };
+	});
+
+	result.emplace_back("random_access", [](std::size_t size)
+	{
+		const Container container = filledContainer<Container>(size);
+		std::mt19937_64 generator(42);
+		std::uniform_int_distribution<std::size_t> distribution(0, size - 1);
+		std::vector<std::size_t> indices(size);
+		for (std::size_t& index : indices)
+			index = distribution(generator);
+
+		std::uint64_t sum = 0;
+		Timer timer;
+		for (std::size_t index : indices)
+			sum += touch(container[index]);
+		double seconds = timer.seconds();
+		doNotOptimize(sum);
+		return Measurement{ static_cast<double>(size), seconds };
+	});
+
+	result.emplace_back("iterate", [](std::size_t size)
+	{
+		const Container container = filledContainer<Container>(size);
+		std::uint64_t sum = 0;
+		Timer timer;
+		for (const T& element : container)
+			sum += touch(element);
+		double seconds = timer.seconds();
+		doNotOptimize(sum);
+		return Measurement{ static_cast<double>(size), seconds };
+	});
+
+	if constexpr (Traits::hasMiddle)
+	{
+		//every insert and remove shifts half of the container,so the number of operations shrinks as the container grows
+		result.emplace_back("insert_middle", [](std::size_t size)
+		{
+			Container container = filledContainer<Container>(size);
+			std::size_t operations = std::max<std::size_t>(1, std::min<std::size_t>(size, 10000000 / size));
+			T value = makeValue<T>(size);
+			Timer timer;
+			for (std::size_t i = 0; i < operations; i++)
+				insertMiddle(container, container.size() / 2, value);
+			return Measurement{ static_cast<double>(operations), timer.seconds() };
+		});
+
+		result.emplace_back("remove_middle", [](std::size_t size)
+		{
+			Container container = filledContainer<Container>(size);
+			std::size_t operations = std::max<std::size_t>(1, std::min<std::size_t>(size, 10000000 / size));
+			Timer timer;
+			for (std::size_t i = 0; i < operations; i++)
+				removeMiddle(container, container.size() / 2);
+			return Measurement{ static_cast<double>(operations), timer.seconds() };
+		});
+	}
+
+	//the time to copy the container,counted per element.A Deque copy shares its blocks,so it doesn't copy the elements
+	result.emplace_back("copy", [](std::size_t size)
+	{
+		const Container container = filledContainer<Container>(size);
+		Timer timer;
+		Container copy(container);
+		double seconds = timer.seconds();
+		doNotOptimize(copy.size());
+		return Measurement{ static_cast<double>(size), seconds };
+	});
+
+	result.emplace_back("clear", [](std::size_t size)
+	{
+		Container container = filledContainer<Container>(size);
+		Timer timer;
+		container.clear();
+		return Measurement{ static_cast<double>(size), timer.seconds() };
+	});
+
+	return result;
+}
+
+//repeats every workload until it has gone through at least minOperations elements,so small sizes aren't dominated by timer noise
+template<typename Container>
+void runContainer(const std::string& containerName, const std::string& typeName, const std::vector<std::size_t>& sizes, std::size_t minOperations, std::vector<Result>& results)
+{
+	for (const auto& [benchmarkName, workload] : workloads<Container>())
+	{
+		for (std::size_t size : sizes)
+		{
+			std::size_t repetitions = std::max<std::size_t>(1, minOperations / size);
+			Measurement total{ 0, 0 };
+			for (std::size_t i = 0; i < repetitions; i++)
+			{
+				Measurement measurement = workload(size);
+				total.operations += measurement.operations;
+				total.seconds += measurement.seconds;
+			}
+
+			results.push_back({ benchmarkName, containerName, typeName, size, total });
+			std::cerr << benchmarkName << " " << containerName << "<" << typeName << "> " << size << ": " << total.seconds * 1e9 / total.operations << " ns/op, " << total.seconds * 1e9 * cyclesPerNanosecond() / total.operations << " cycles/op" << std::endl;
+		}
+	}
+}
+
+template<typename T>
+void runType(const std::string& typeName, const std::vector<std::size_t>& sizes, std::size_t minOperations, std::vector<Result>& results)
+{
+	runContainer<Deque<T>>("Deque", typeName, sizes, minOperations, results);
+	runContainer<std::deque<T>>("std::deque", typeName, sizes, minOperations, results);
+	runContainer<std::vector<T>>("std::vector", typeName, sizes, minOperations, results);
+	runContainer<BoundedDeque<T>>("BoundedDeque", typeName, sizes, minOperations, results);
+}
+
+std::vector<std::string> splitList(const std::string& list)
+{
+	std::vector<std::string> items;
+	std::stringstream stream(list);
+	std::string item;
+	while (std::getline(stream, item, ','))
+	{
+		if (!item.empty())
+			items.push_back(item);
+	}
+	return items;
+}
+
+void writeJson(std::ostream& output, const std::string& commit, const std::vector<Result>& results)
+{
+	output << "{\n";
+	output << "  \"commit\": \"" << commit << "\",\n";
+#if defined(__VERSION__)
+	output << "  \"compiler\": \"" << __VERSION__ << "\",\n";
+#endif
+	output << "  \"results\": [\n";
+	for (std::size_t i = 0; i < results.size(); i++)
+	{
+		const Result& result = results[i];
+		output << "    {\"benchmark\": \"" << result.benchmark << "\", \"container\": \"" << result.container << "\", \"type\": \"" << result.type << "\", \"size\": " << result.size
+			<< ", \"operations\": " << static_cast<std::uint64_t>(result.measurement.operations) << ", \"seconds\": " << result.measurement.seconds
+			<< ", \"ns_per_op\": " << result.measurement.seconds * 1e9 / result.measurement.operations
+			<< ", \"cycles_per_op\": " << result.measurement.seconds * 1e9 * cyclesPerNanosecond() / result.measurement.operations << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+	}
+	output << "  ]\n";
+	output << "}\n";
+}
+
+int main(int argc, char* argv[])
+{
+	std::vector<std::size_t> sizes = { 1000, 100000, 1000000 };
+	std::vector<std::string> types = { "int", "pod64", "string" };
+	std::size_t minOperations = 1000000;
+	std::string commit = "unknown";
+	std::string outputPath;
+
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		std::string option = argv[i];
+		std::string value = argv[i + 1];
+		if (option == "--sizes")
+		{
+			sizes.clear();
+			for (const std::string& size : splitList(value))
+				sizes.push_back(std::stoull(size));
+		}
+		else if (option == "--types")
+		{
+			types = splitList(value);
+		}
+		else if (option == "--min-ops")
+		{
+			minOperations = std::stoull(value);
+		}
+		else if (option == "--commit")
+		{
+			commit = value;
+		}
+		else if (option == "--output")
+		{
+			outputPath = value;
+		}
+		else
+		{
+			std::cerr << "unknown option " << option << std::endl;
+			return 1;
+		}
+	}
+
+	std::vector<Result> results;
+	for (const std::string& type : types)
+	{
+		if (type == "int")
+			runType<int>(type, sizes, minOperations, results);
+		else if (type == "pod64")
+			runType<Pod64>(type, sizes, minOperations, results);
+		else if (type == "string")
+			runType<std::string>(type, sizes, minOperations, results);
+		else
+			std::cerr << "unknown type " << type << std::endl;
+	}
+
+	if (outputPath.empty())
+	{
+		writeJson(std::cout, commit, results);
+	}
+	else
+	{
+		std::ofstream output(outputPath);
+		writeJson(output, commit, results);
+	}
+
+	return 0;
+}
@@ -0,0 +1,103 @@
+#include"../Deque/Deque.h"
+#include"../Deque/DequeParallel.h"
+#include"BenchmarkUtils.h"
+#include<algorithm>
+#include<cstdint>
+#include<numeric>
+#include<random>
+#include<thread>
+#include<vector>
+
+//runs for_each,transform,reduce,count_if and sort over one deque with 1 up to N threads and compares them with the sequential loop over Deque::Iterator
+//usage: ParallelBenchmark [elementCount] [maxThreads]
+
+std::vector<std::size_t> threadCounts(std::size_t maxThreads)
+{
+	std::vector<std::size_t> counts;
+	for (std::size_t count = 1; count < maxThreads; count *= 2)
+		counts.push_back(count);
+	counts.push_back(maxThreads);
+	return counts;
+}
+
+void printSpeedup(const std::string& name, double operations, double seconds, double sequentialSeconds)
+{
+	std::cout << name << ": " << operations / seconds / 1e6 << " Mops/s (" << seconds * 1e9 / operations << " ns/op), " << sequentialSeconds / seconds << "x the iterator loop" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t elementCount = argc > 1 ? std::stoull(argv[1]) : 50000000;
+	std::size_t maxThreads = argc > 2 ? std::stoull(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+
+	std::vector<std::uint32_t> values(elementCount);
+	std::mt19937 random(42);
+	for (std::uint32_t& value : values)
+		value = random();
+
+	Deque<std::uint32_t> deque;
+	deque.append(values.begin(), values.end());
+	double operations = static_cast<double>(elementCount);
+	auto isEven = [](std::uint32_t value) { return value % 2 == 0; };
+	auto scale = [](std::uint32_t value) { return value * 3 + 1; };
+
+	Timer forEachTimer;
+	for (auto it = deque.begin(); it != deque.end(); ++it)
+		*it = scale(*it);
+	double forEachSeconds = forEachTimer.seconds();
+	printResult("for_each iterator loop", operations, forEachSeconds);
+
+	std::vector<std::uint32_t> output(elementCount);
+	Timer transformTimer;
+	std::transform(deque.cbegin(), deque.cend(), output.begin(), scale);
+	double transformSeconds = transformTimer.seconds();
+	printResult("transform iterator loop", operations, transformSeconds);
+
+	Timer reduceTimer;
+	std::uint64_t sum = 0;
+	for (auto it = deque.cbegin(); it != deque.cend(); ++it)
+		sum += *it;
+	doNotOptimize(sum);
+	double reduceSeconds = reduceTimer.seconds();
+	printResult("reduce iterator loop", operations, reduceSeconds);
+
+	Timer countTimer;
+	doNotOptimize(std::count_if(deque.cbegin(), deque.cend(), isEven));
+	double countSeconds = countTimer.seconds();
+	printResult("count_if iterator loop", operations, countSeconds);
+
+	deque.assign(values.begin(), values.end());
+	Timer sortTimer;
+	std::sort(deque.begin(), deque.end());
+	double sortSeconds = sortTimer.seconds();
+	printResult("sort iterator loop", operations, sortSeconds);
+
+	for (std::size_t threads : threadCounts(maxThreads))
+	{
+		DequeThreadPool pool(threads);
+		std::string suffix = " " + std::to_string(threads) + " threads";
+
+		Timer parallelForEachTimer;
+		parallel_for_each(pool, deque, [&](std::uint32_t& value) { value = scale(value); });
+		printSpeedup("parallel_for_each" + suffix, operations, parallelForEachTimer.seconds(), forEachSeconds);
+
+		Timer parallelTransformTimer;
+		parallel_transform(pool, std::as_const(deque), output.begin(), scale);
+		printSpeedup("parallel_transform" + suffix, operations, parallelTransformTimer.seconds(), transformSeconds);
+
+		Timer parallelReduceTimer;
+		doNotOptimize(parallel_reduce(pool, deque, std::uint64_t(0)));
+		printSpeedup("parallel_reduce" + suffix, operations, parallelReduceTimer.seconds(), reduceSeconds);
+
+		Timer parallelCountTimer;
+		doNotOptimize(parallel_count_if(pool, deque, isEven));
+		printSpeedup("parallel_count_if" + suffix, operations, parallelCountTimer.seconds(), countSeconds);
+
+		deque.assign(values.begin(), values.end());
+		Timer parallelSortTimer;
+		parallel_sort(pool, deque);
+		printSpeedup("parallel_sort" + suffix, operations, parallelSortTimer.seconds(), sortSeconds);
+	}
+
+	return 0;
+}
@@ -0,0 +1,162 @@
+#include"../Deque/Deque.h"
+#include"../Deque/HugePageAllocator.h"
+#include"BenchmarkUtils.h"
+#include<algorithm>
+#include<cstdint>
+#include<numeric>
+#include<random>
+#include<vector>
+
+//scans deques that don't fit in the cache with the iterator and with segments(),once with blocks at scattered addresses and once with blocks from HugePageAllocator.Built twice by CMake:PrefetchBenchmark with the default prefetch distance and PrefetchBenchmarkNoPrefetch with DEQUE_PREFETCH_DISTANCE=0
+//usage: PrefetchBenchmark [elementCount]
+
+//hands out the chunks of one large buffer in a random order,so consecutive blocks of a deque are far apart in memory like in a long running program and the hardware prefetcher can't guess the next block
+class ScatteredChunks
+{
+	static constexpr std::size_t mChunkBytes = 1024;
+
+	std::vector<unsigned char*> freeChunks;
+	unsigned char* buffer;
+	std::size_t bufferBytes;
+
+public:
+	explicit ScatteredChunks(std::size_t chunkCount) : buffer(static_cast<unsigned char*>(::operator new(chunkCount * mChunkBytes, std::align_val_t(64)))), bufferBytes(chunkCount * mChunkBytes)
+	{
+		for (std::size_t i = 0; i < chunkCount; i++)
+			freeChunks.push_back(buffer + i * mChunkBytes);
+		std::shuffle(freeChunks.begin(), freeChunks.end(), std::mt19937(42));
+	}
+
+	ScatteredChunks(const ScatteredChunks&) = delete;
+	ScatteredChunks& operator=(const ScatteredChunks&) = delete;
+
+	~ScatteredChunks()
+	{
+		::operator delete(buffer, std::align_val_t(64));
+	}
+
+	static ScatteredChunks*& current()
+	{
+		static ScatteredChunks* chunks = nullptr;
+		return chunks;
+	}
+
+	bool fits(std::size_t bytes, std::size_t alignment) const
+	{
+		return bytes <= mChunkBytes && alignment <= 64 && !freeChunks.empty();
+	}
+
+	void* allocate()
+	{
+		void* chunk = freeChunks.back();
+		freeChunks.pop_back();
+		return chunk;
+	}
+
+	bool owns(const void* pointer) const
+	{
+		const unsigned char* address = static_cast<const unsigned char*>(pointer);
+		return address >= buffer && address < buffer + bufferBytes;
+	}
+
+	void deallocate(void* pointer)
+	{
+		freeChunks.push_back(static_cast<unsigned char*>(pointer));
+	}
+};
+
+template<typename T>
+class ScatteredAllocator
+{
+public:
+	using value_type = T;
+
+	ScatteredAllocator() noexcept {}
+
+	template<typename U>
+	ScatteredAllocator(const ScatteredAllocator<U>&) noexcept {}
+
+	T* allocate(std::size_t count)
+	{
+		ScatteredChunks* chunks = ScatteredChunks::current();
+		if (count == 1 && chunks->fits(sizeof(T), alignof(T)))  //the blocks,the block directory takes the normal path
+			return static_cast<T*>(chunks->allocate());
+		return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+	}
+
+	void deallocate(T* pointer, std::size_t count)
+	{
+		if (count == 1 && ScatteredChunks::current()->owns(pointer))
+			ScatteredChunks::current()->deallocate(pointer);
+		else
+			::operator delete(pointer, std::align_val_t(alignof(T)));
+	}
+
+	template<typename U>
+	bool operator==(const ScatteredAllocator<U>&) const noexcept { return true; }
+
+	template<typename U>
+	bool operator!=(const ScatteredAllocator<U>&) const noexcept { return false; }
+};
+
+//writes a buffer larger than the last level cache,so the deque is read from memory in the next scan
+void evictCaches(std::vector<std::uint64_t>& evictionBuffer)
+{
+	for (std::size_t i = 0; i < evictionBuffer.size(); i += 8)
+		evictionBuffer[i]++;
+	doNotOptimize(evictionBuffer.data());
+}
+
+template<typename DequeType>
+void scan(const std::string& name, const DequeType& deque, std::vector<std::uint64_t>& evictionBuffer)
+{
+	double operations = static_cast<double>(deque.size());
+
+	evictCaches(evictionBuffer);
+	Timer iteratorTimer;
+	std::uint64_t sum = 0;
+	for (auto it = deque.cbegin(); it != deque.cend(); ++it)
+		sum += *it;
+	doNotOptimize(sum);
+	printResult(name + " iterator scan", operations, iteratorTimer.seconds());
+
+	evictCaches(evictionBuffer);
+	Timer segmentTimer;
+	sum = 0;
+	for (std::span<const std::uint64_t> segment : deque.segments())
+		sum = std::accumulate(segment.begin(), segment.end(), sum);
+	doNotOptimize(sum);
+	printResult(name + " segments scan", operations, segmentTimer.seconds());
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t elementCount = argc > 1 ? std::stoull(argv[1]) : 16000000;
+	std::vector<std::uint64_t> evictionBuffer(std::size_t(64) << 20 >> 3);
+	std::cout << "prefetch distance: " << DEQUE_PREFETCH_DISTANCE << " blocks" << std::endl;
+
+	{
+		ScatteredChunks chunks(elementCount / 64 + 64);
+		ScatteredChunks::current() = &chunks;
+		Deque<std::uint64_t, 512, ScatteredAllocator<std::uint64_t>> deque;
+		for (std::size_t i = 0; i < elementCount; i++)
+			deque.push_back(i);
+		scan("scattered blocks", deque, evictionBuffer);
+	}
+
+	{
+		Deque<std::uint64_t, 512, HugePageAllocator<std::uint64_t>> deque;
+		for (std::size_t i = 0; i < elementCount; i++)
+			deque.push_back(i);
+		scan("huge page blocks", deque, evictionBuffer);
+	}
+
+	{
+		Deque<std::uint64_t> deque;
+		for (std::size_t i = 0; i < elementCount; i++)
+			deque.push_back(i);
+		scan("default allocator", deque, evictionBuffer);
+	}
+
+	return 0;
+}
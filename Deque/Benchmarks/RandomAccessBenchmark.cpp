@@ -0,0 +1,45 @@
+#include"../Deque/Deque.h"
+#include"BenchmarkUtils.h"
+#include<deque>
+#include<random>
+#include<vector>
+
+//measures the throughput of random indexed reads on a large deque
+template<typename Container>
+void benchmarkRandomReads(const std::string& name, Container& container, const std::vector<std::size_t>& indices)
+{
+	long long sum = 0;
+	Timer timer;
+	for (std::size_t index : indices)
+		sum += container[index];
+	double seconds = timer.seconds();
+
+	doNotOptimize(sum);
+	printResult(name, static_cast<double>(indices.size()), seconds);
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t elementCount = argc > 1 ? std::stoull(argv[1]) : 10000000;
+	std::size_t readCount = argc > 2 ? std::stoull(argv[2]) : 10000000;
+
+	Deque<int> deque;
+	std::deque<int> stdDeque;
+	for (std::size_t i = 0; i < elementCount; i++)
+	{
+		deque.push_back(static_cast<int>(i));
+		stdDeque.push_back(static_cast<int>(i));
+	}
+
+	std::mt19937_64 generator(42);
+	std::uniform_int_distribution<std::size_t> distribution(0, elementCount - 1);
+	std::vector<std::size_t> indices(readCount);
+	for (std::size_t& index : indices)
+		index = distribution(generator);
+
+	std::cout << "Random reads over " << elementCount << " elements" << std::endl;
+	benchmarkRandomReads("std::deque", stdDeque, indices);
+	benchmarkRandomReads("Deque", deque, indices);
+
+	return 0;
+}
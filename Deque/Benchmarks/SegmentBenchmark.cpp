@@ -0,0 +1,54 @@
+#include"../Deque/Deque.h"
+#include"../Deque/DequeAlgorithms.h"
+#include"BenchmarkUtils.h"
+#include<numeric>
+#include<vector>
+
+//sums the same deque by stepping its iterator and by walking its segments,a vector of the same size shows the speed of a plain contiguous loop
+template<typename T>
+void benchmarkSum(const std::string& typeName, std::size_t elementCount, std::size_t repetitions)
+{
+	Deque<T> deque;
+	std::vector<T> vector;
+	for (std::size_t i = 0; i < elementCount; i++)
+	{
+		deque.push_back(static_cast<T>(i % 100));
+		vector.push_back(static_cast<T>(i % 100));
+	}
+	deque.pop_front();  //the first block is only partly used,as it is in a queue
+	vector.erase(vector.begin());
+
+	double operations = static_cast<double>(vector.size() * repetitions);
+
+	Timer iteratorTimer;
+	for (std::size_t i = 0; i < repetitions; i++)
+	{
+		T sum = 0;
+		for (auto it = deque.begin(); it != deque.end(); ++it)
+			sum += *it;
+		doNotOptimize(sum);
+	}
+	printResult(typeName + " iterator loop", operations, iteratorTimer.seconds());
+
+	Timer segmentTimer;
+	for (std::size_t i = 0; i < repetitions; i++)
+		doNotOptimize(segmented_accumulate(deque, T(0)));
+	printResult(typeName + " segmented_accumulate", operations, segmentTimer.seconds());
+
+	Timer vectorTimer;
+	for (std::size_t i = 0; i < repetitions; i++)
+		doNotOptimize(std::accumulate(vector.begin(), vector.end(), T(0)));
+	printResult(typeName + " std::vector accumulate", operations, vectorTimer.seconds());
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t elementCount = argc > 1 ? std::stoull(argv[1]) : 1000000;
+	std::size_t repetitions = argc > 2 ? std::stoull(argv[2]) : 200;
+
+	benchmarkSum<int>("int", elementCount, repetitions);
+	benchmarkSum<float>("float", elementCount, repetitions);
+	benchmarkSum<long long>("long long", elementCount, repetitions);
+
+	return 0;
+}
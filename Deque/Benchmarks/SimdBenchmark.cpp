@@ -0,0 +1,91 @@
+#include"../Deque/Deque.h"
+#include"../Deque/DequeAlgorithms.h"
+#include"../Deque/DequeSimd.h"
+#include"BenchmarkUtils.h"
+#include<algorithm>
+#include<numeric>
+
+//compares the vector kernels with the standard algorithms over Deque::Iterator.Build it once as it is and once with -mavx2 to see the SSE2 and the AVX2 kernels
+template<typename T, std::size_t BlockBytes>
+void benchmarkKernels(const std::string& typeName, std::size_t elementCount, std::size_t repetitions)
+{
+	std::string name = typeName + " BlockBytes=" + std::to_string(BlockBytes);
+	Deque<T, BlockBytes> deque;
+	for (std::size_t i = 0; i < elementCount; i++)
+		deque.push_back(static_cast<T>(i % 1000));
+	deque.pop_front();
+	T missing = static_cast<T>(-1);  //find and any_of have to scan the whole deque
+
+	double operations = static_cast<double>(deque.size() * repetitions);
+
+	Timer accumulateTimer;
+	for (std::size_t i = 0; i < repetitions; i++)
+		doNotOptimize(std::accumulate(deque.begin(), deque.end(), SimdSumType<T>(0)));
+	printResult(name + " std::accumulate", operations, accumulateTimer.seconds());
+
+	Timer segmentedTimer;
+	for (std::size_t i = 0; i < repetitions; i++)
+		doNotOptimize(segmented_accumulate(deque, SimdSumType<T>(0)));
+	printResult(name + " segmented_accumulate", operations, segmentedTimer.seconds());
+
+	Timer sumTimer;
+	for (std::size_t i = 0; i < repetitions; i++)
+		doNotOptimize(simd_sum(deque));
+	printResult(name + " simd_sum", operations, sumTimer.seconds());
+
+	Timer findTimer;
+	for (std::size_t i = 0; i < repetitions; i++)
+		doNotOptimize(std::find(deque.begin(), deque.end(), missing));
+	printResult(name + " std::find", operations, findTimer.seconds());
+
+	Timer simdFindTimer;
+	for (std::size_t i = 0; i < repetitions; i++)
+		doNotOptimize(simd_find(deque, missing));
+	printResult(name + " simd_find", operations, simdFindTimer.seconds());
+
+	Timer countTimer;
+	for (std::size_t i = 0; i < repetitions; i++)
+		doNotOptimize(std::count(deque.begin(), deque.end(), static_cast<T>(7)));
+	printResult(name + " std::count", operations, countTimer.seconds());
+
+	Timer simdCountTimer;
+	for (std::size_t i = 0; i < repetitions; i++)
+		doNotOptimize(simd_count(deque, static_cast<T>(7)));
+	printResult(name + " simd_count", operations, simdCountTimer.seconds());
+
+	Timer minTimer;
+	for (std::size_t i = 0; i < repetitions; i++)
+		doNotOptimize(*std::min_element(deque.begin(), deque.end()));
+	printResult(name + " std::min_element", operations, minTimer.seconds());
+
+	Timer simdMinTimer;
+	for (std::size_t i = 0; i < repetitions; i++)
+		doNotOptimize(simd_min(deque));
+	printResult(name + " simd_min", operations, simdMinTimer.seconds());
+
+	Timer anyTimer;
+	for (std::size_t i = 0; i < repetitions; i++)
+		doNotOptimize(simd_any_of(deque, SimdCompare::Less, missing));
+	printResult(name + " simd_any_of", operations, anyTimer.seconds());
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t elementCount = argc > 1 ? std::stoull(argv[1]) : 1000000;
+	std::size_t repetitions = argc > 2 ? std::stoull(argv[2]) : 100;
+
+#if defined(DEQUE_SIMD_AVX2)
+	std::cout << "kernels: AVX2" << std::endl;
+#elif defined(DEQUE_SIMD_SSE2)
+	std::cout << "kernels: SSE2" << std::endl;
+#else
+	std::cout << "kernels: scalar" << std::endl;
+#endif
+
+	benchmarkKernels<std::int32_t, 512>("int32_t", elementCount, repetitions);
+	benchmarkKernels<std::int32_t, 4096>("int32_t", elementCount, repetitions);
+	benchmarkKernels<float, 512>("float", elementCount, repetitions);
+	benchmarkKernels<double, 512>("double", elementCount, repetitions);
+
+	return 0;
+}
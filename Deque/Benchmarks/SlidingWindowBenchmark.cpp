@@ -0,0 +1,81 @@
+#include"../Deque/Deque.h"
+#include"../Deque/DequeAlgorithms.h"
+#include"../Deque/SlidingWindow.h"
+#include"BenchmarkUtils.h"
+#include<algorithm>
+#include<random>
+#include<string>
+#include<vector>
+
+//a tick stream where every tick pushes a price,evicts the oldest one once the window is full and queries the window
+std::vector<double> makeTicks(std::size_t count)
+{
+	std::mt19937_64 generator(7);
+	std::normal_distribution<double> step(0.0, 1.0);
+	std::vector<double> ticks(count);
+	double price = 100.0;
+	for (double& tick : ticks)
+	{
+		price += step(generator);
+		tick = price;
+	}
+	return ticks;
+}
+
+template<typename Window, typename Query>
+void benchmarkWindow(const std::string& name, const std::vector<double>& ticks, std::size_t windowSize, Query query)
+{
+	Window window;
+	double checksum = 0;
+	Timer timer;
+	for (std::size_t i = 0; i < ticks.size(); i++)
+	{
+		window.push(ticks[i]);
+		if (i >= windowSize)
+			window.evict();
+		checksum += query(window);
+	}
+	printResult(name, static_cast<double>(ticks.size()), timer.seconds());
+	doNotOptimize(checksum);
+}
+
+//the window is kept in a Deque and the answer is computed from all of its values on every tick.The window is filled before the timer starts and only steps ticks are timed,because a recompute costs a visit of every value in the window
+template<typename Compute>
+void benchmarkRecompute(const std::string& name, const std::vector<double>& ticks, std::size_t windowSize, std::size_t steps, Compute compute)
+{
+	Deque<double> window;
+	window.append(ticks.begin(), ticks.begin() + windowSize);
+	double checksum = 0;
+	Timer timer;
+	for (std::size_t i = windowSize; i < windowSize + steps; i++)
+	{
+		window.push_back(ticks[i]);
+		window.pop_front();
+		checksum += compute(std::as_const(window));
+	}
+	printResult(name, static_cast<double>(steps), timer.seconds());
+	doNotOptimize(checksum);
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t tickCount = argc > 1 ? std::stoull(argv[1]) : 10000000;
+	std::size_t recomputeWork = argc > 2 ? std::stoull(argv[2]) : 200000000;  //the naive versions get fewer ticks for big windows,so each of them visits about recomputeWork values
+	std::vector<double> ticks = makeTicks(tickCount);
+
+	for (std::size_t windowSize : { 1000, 10000, 100000, 1000000 })
+	{
+		std::cout << "window of " << windowSize << " ticks:" << std::endl;
+		std::size_t steps = std::min(ticks.size() - windowSize, std::max<std::size_t>(1, recomputeWork / windowSize));
+
+		benchmarkWindow<SlidingWindowMin<double>>("  SlidingWindowMin", ticks, windowSize, [](const auto& window) { return window.query(); });
+		benchmarkWindow<SlidingWindowMax<double>>("  SlidingWindowMax", ticks, windowSize, [](const auto& window) { return window.query(); });
+		benchmarkWindow<SlidingWindowSum<double>>("  SlidingWindowSum (mean)", ticks, windowSize, [](const auto& window) { return window.query() / static_cast<double>(window.size()); });
+
+		benchmarkRecompute("  recompute min", ticks, windowSize, steps, [](const Deque<double>& window) { return *std::min_element(window.begin(), window.end()); });
+		benchmarkRecompute("  recompute max", ticks, windowSize, steps, [](const Deque<double>& window) { return *std::max_element(window.begin(), window.end()); });
+		benchmarkRecompute("  recompute mean", ticks, windowSize, steps, [](const Deque<double>& window) { return segmented_accumulate(window, 0.0) / static_cast<double>(window.size()); });
+	}
+
+	return 0;
+}
@@ -0,0 +1,47 @@
+#define DEQUE_BENCHMARK_COUNT_ALLOCATIONS
+#include"../Deque/Deque.h"
+#include"../Deque/SmallDeque.h"
+#include"BenchmarkUtils.h"
+#include<deque>
+
+//creates millions of short-lived queues,like the pending requests of a connection,pushes a few elements,drains them and destroys the queue.Every call to the global operator new is counted
+//usage: SmallDequeBenchmark [queueCount]
+
+template<typename Container>
+void benchmarkShortLived(const std::string& name, std::size_t queueCount, std::size_t depth)
+{
+	std::size_t allocationsBefore = allocationCount;
+	std::uint64_t sum = 0;
+	Timer timer;
+	for (std::size_t i = 0; i < queueCount; i++)
+	{
+		Container container;
+		for (std::size_t j = 0; j < depth; j++)
+			container.push_back(static_cast<int>(i + j));
+		while (!container.empty())
+		{
+			sum += container.front();
+			container.pop_front();
+		}
+	}
+	double seconds = timer.seconds();
+	doNotOptimize(sum);
+	std::size_t allocations = allocationCount - allocationsBefore;
+
+	printResult(name + " depth " + std::to_string(depth), static_cast<double>(queueCount), seconds);
+	std::cout << "  heap allocations per queue: " << static_cast<double>(allocations) / static_cast<double>(queueCount) << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t queueCount = argc > 1 ? std::stoull(argv[1]) : 5000000;
+
+	for (std::size_t depth : { 1, 4, 16, 64 })
+	{
+		benchmarkShortLived<std::deque<int>>("std::deque", queueCount, depth);
+		benchmarkShortLived<Deque<int>>("Deque", queueCount, depth);
+		benchmarkShortLived<SmallDeque<int, 16>>("SmallDeque<int, 16>", queueCount, depth);
+	}
+
+	return 0;
+}
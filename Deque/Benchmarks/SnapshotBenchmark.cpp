@@ -0,0 +1,99 @@
+#include"../Deque/Deque.h"
+#include"../Deque/DequeAlgorithms.h"
+#include"BenchmarkUtils.h"
+#include<deque>
+#include<numeric>
+#include<utility>
+
+//takes snapshots of a big deque the way a writer hands a consistent view to readers.A Deque copy shares the blocks,the deep copy is what every snapshot cost before the blocks were shared
+void benchmarkSnapshot(std::size_t elementCount, std::size_t snapshots)
+{
+	Deque<int> deque;
+	std::deque<int> standardDeque;
+	for (std::size_t i = 0; i < elementCount; i++)
+	{
+		deque.push_back(static_cast<int>(i % 100));
+		standardDeque.push_back(static_cast<int>(i % 100));
+	}
+
+	Timer shareTimer;
+	for (std::size_t i = 0; i < snapshots; i++)
+	{
+		Deque<int> snapshot(deque);
+		doNotOptimize(snapshot.size());
+	}
+	printResult("Deque snapshot", static_cast<double>(snapshots), shareTimer.seconds());
+
+	Timer deepCopyTimer;
+	for (std::size_t i = 0; i < snapshots; i++)
+	{
+		Deque<int> snapshot;
+		snapshot.append(deque.cbegin(), deque.cend());
+		doNotOptimize(snapshot.size());
+	}
+	printResult("Deque deep copy", static_cast<double>(snapshots), deepCopyTimer.seconds());
+
+	Timer standardTimer;
+	for (std::size_t i = 0; i < snapshots; i++)
+	{
+		std::deque<int> snapshot(standardDeque);
+		doNotOptimize(snapshot.size());
+	}
+	printResult("std::deque copy", static_cast<double>(snapshots), standardTimer.seconds());
+}
+
+//a reader sums a snapshot while the writer keeps pushing and popping its own deque.Reading a snapshot goes through the const interface,so it costs the same as reading an unshared deque,and the writer only clones the blocks at the ends it touches
+void benchmarkReadAfterSnapshot(std::size_t elementCount, std::size_t repetitions, std::size_t writesPerSnapshot)
+{
+	Deque<int> deque;
+	for (std::size_t i = 0; i < elementCount; i++)
+		deque.push_back(static_cast<int>(i % 100));
+
+	double readOperations = static_cast<double>(elementCount * repetitions);
+
+	Timer unsharedTimer;
+	for (std::size_t i = 0; i < repetitions; i++)
+		doNotOptimize(segmented_accumulate(std::as_const(deque), 0LL));
+	printResult("read unshared deque", readOperations, unsharedTimer.seconds());
+
+	const Deque<int> snapshot(deque);
+	Timer snapshotTimer;
+	for (std::size_t i = 0; i < repetitions; i++)
+		doNotOptimize(segmented_accumulate(snapshot, 0LL));
+	printResult("read snapshot", readOperations, snapshotTimer.seconds());
+
+	Timer writeTimer;
+	for (std::size_t i = 0; i < repetitions; i++)
+	{
+		Deque<int> readerView(deque);
+		for (std::size_t j = 0; j < writesPerSnapshot; j++)
+		{
+			deque.push_back(static_cast<int>(j));
+			deque.pop_front();
+		}
+		doNotOptimize(readerView.size());
+	}
+	printResult("snapshot + writer push/pop", static_cast<double>(writesPerSnapshot * repetitions), writeTimer.seconds());
+
+	Timer plainWriteTimer;
+	for (std::size_t i = 0; i < repetitions; i++)
+	{
+		for (std::size_t j = 0; j < writesPerSnapshot; j++)
+		{
+			deque.push_back(static_cast<int>(j));
+			deque.pop_front();
+		}
+	}
+	printResult("writer push/pop without snapshots", static_cast<double>(writesPerSnapshot * repetitions), plainWriteTimer.seconds());
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t elementCount = argc > 1 ? std::stoull(argv[1]) : 5000000;
+	std::size_t snapshots = argc > 2 ? std::stoull(argv[2]) : 20;
+
+	benchmarkSnapshot(elementCount, snapshots);
+	benchmarkReadAfterSnapshot(elementCount, snapshots, 10000);
+
+	return 0;
+}
@@ -0,0 +1,74 @@
+#include"../Deque/SpillingDeque.h"
+#include"BenchmarkUtils.h"
+#include<cstdint>
+#include<filesystem>
+#include<fstream>
+#include<string>
+#include<sys/resource.h>
+
+//the resident memory of the process in MB,read from /proc so the numbers show that it stays bounded while the deque grows
+double residentMegabytes()
+{
+	std::ifstream statm("/proc/self/statm");
+	std::size_t pages = 0, residentPages = 0;
+	statm >> pages >> residentPages;
+	return static_cast<double>(residentPages) * static_cast<double>(sysconf(_SC_PAGESIZE)) / 1e6;
+}
+
+void printMemory(const SpillingDeque<std::uint64_t>& deque)
+{
+	std::cout << "  " << deque.size() << " elements, " << deque.resident_segments() << " segments mapped, " << deque.spilled_segments() << " spilled, resident memory " << residentMegabytes() << " MB" << std::endl;
+}
+
+//a backlog builds up while the consumer is down,then drains while the producer keeps pushing at half the rate.The elements are 8 bytes,so the deque holds elementCount * 8 bytes on disk while the resident memory stays at a few segments
+void benchmarkBacklog(const std::filesystem::path& directory, std::size_t elementCount, std::size_t residentSegments, std::size_t segmentBytes)
+{
+	SpillingDeque<std::uint64_t> deque(directory, residentSegments, segmentBytes);
+	double bytes = static_cast<double>(elementCount * sizeof(std::uint64_t));
+
+	Timer fillTimer;
+	for (std::size_t i = 0; i < elementCount; i++)
+		deque.push_back(i);
+	double fillSeconds = fillTimer.seconds();
+	printResult("fill (push_back only)", static_cast<double>(elementCount), fillSeconds);
+	std::cout << "  " << bytes / fillSeconds / 1e6 << " MB/s" << std::endl;
+	printMemory(deque);
+
+	//every round pops two elements and pushes one,so the consumer reads spilled segments while the producer writes new ones
+	std::uint64_t sum = 0;
+	std::size_t next = elementCount;
+	Timer drainTimer;
+	while (!deque.empty())
+	{
+		sum += deque.front();
+		deque.pop_front();
+		if (!deque.empty())
+		{
+			sum += deque.front();
+			deque.pop_front();
+		}
+		if (next < elementCount + elementCount / 2)
+			deque.push_back(next++);
+	}
+	double drainSeconds = drainTimer.seconds();
+	double drainOperations = static_cast<double>(next + (next - elementCount));
+	printResult("drain with a producer (pop_front + push_back)", drainOperations, drainSeconds);
+	doNotOptimize(sum);
+	printMemory(deque);
+
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	std::cout << "peak resident memory: " << static_cast<double>(usage.ru_maxrss) / 1e3 << " MB for " << bytes / 1e6 << " MB of elements" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t elementCount = argc > 1 ? std::stoull(argv[1]) : 100000000;
+	std::filesystem::path directory = argc > 2 ? std::filesystem::path(argv[2]) : std::filesystem::temp_directory_path();
+	std::size_t residentSegments = argc > 3 ? std::stoull(argv[3]) : 4;
+	std::size_t segmentBytes = argc > 4 ? std::stoull(argv[4]) : 1 << 22;
+
+	benchmarkBacklog(directory, elementCount, residentSegments, segmentBytes);
+
+	return 0;
+}
@@ -0,0 +1,87 @@
+#include"../Deque/Deque.h"
+#include"BenchmarkUtils.h"
+#include<cstdint>
+
+//hands the elements of one deque to another between two pipeline stages,with splice_back,splice_front and split_at and with popping and pushing every element
+//usage: SpliceBenchmark [elementCount]
+
+Deque<std::uint64_t> filledDeque(std::size_t elementCount, std::size_t offset)
+{
+	Deque<std::uint64_t> deque;
+	for (std::size_t i = 0; i < offset; i++)  //the first element sits offset positions into its block
+		deque.push_back(0);
+	for (std::size_t i = 0; i < elementCount; i++)
+		deque.push_back(i);
+	for (std::size_t i = 0; i < offset; i++)
+		deque.pop_front();
+	return deque;
+}
+
+void printMicroseconds(const std::string& name, double seconds)
+{
+	std::cout << name << ": " << seconds * 1e6 << " us" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t elementCount = argc > 1 ? std::stoull(argv[1]) : 10000000;
+
+	{
+		Deque<std::uint64_t> source = filledDeque(elementCount, 0);
+		Deque<std::uint64_t> target;
+		Timer timer;
+		while (!source.empty())
+		{
+			target.push_back(source.front());
+			source.pop_front();
+		}
+		printMicroseconds("pop_front and push_back every element", timer.seconds());
+	}
+
+	{
+		Deque<std::uint64_t> source = filledDeque(elementCount, 0);
+		Deque<std::uint64_t> target;
+		Timer timer;
+		target.splice_back(std::move(source));
+		printMicroseconds("splice_back into an empty deque", timer.seconds());
+	}
+
+	{
+		//the first deque ends in the middle of a block and the second starts at the next position,so only the smaller part of one block is moved
+		Deque<std::uint64_t> first = filledDeque(elementCount / 2 + 7, 0);
+		Deque<std::uint64_t> second = filledDeque(elementCount / 2, (elementCount / 2 + 7) % 64);
+		Timer timer;
+		first.splice_back(std::move(second));
+		printMicroseconds("splice_back of two deques whose blocks line up", timer.seconds());
+	}
+
+	{
+		Deque<std::uint64_t> first = filledDeque(elementCount / 2, 0);
+		Deque<std::uint64_t> second = filledDeque(elementCount / 2, 0);
+		Timer timer;
+		second.splice_front(std::move(first));
+		printMicroseconds("splice_front of two deques whose blocks line up", timer.seconds());
+	}
+
+	{
+		Deque<std::uint64_t> first = filledDeque(elementCount / 2 + 7, 0);
+		Deque<std::uint64_t> second = filledDeque(elementCount / 2, 3);
+		Timer timer;
+		first.splice_back(std::move(second));
+		printMicroseconds("splice_back of two deques whose blocks don't line up (moves the smaller one)", timer.seconds());
+	}
+
+	{
+		Deque<std::uint64_t> deque = filledDeque(elementCount, 0);
+		Timer timer;
+		Deque<std::uint64_t> back = deque.split_at(elementCount / 2 + 7);
+		double splitSeconds = timer.seconds();
+		printMicroseconds("split_at the middle", splitSeconds);
+
+		Timer joinTimer;
+		deque.splice_back(std::move(back));
+		printMicroseconds("splice_back of the two halves", joinTimer.seconds());
+	}
+
+	return 0;
+}
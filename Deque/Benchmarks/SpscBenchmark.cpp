@@ -0,0 +1,122 @@
+#include"../Deque/ConcurrentSpscDeque.h"
+#include"../Deque/Deque.h"
+#include"BenchmarkUtils.h"
+#include<mutex>
+#include<thread>
+
+//on a machine with one hardware thread a spinning thread only gives up the core at the end of its time slice,so the waiting loops yield there
+static bool yieldWhileWaiting = false;
+
+inline void waitForValue()
+{
+	if (yieldWhileWaiting)
+		std::this_thread::yield();
+}
+
+//the queue the reader and the parser shared before:a Deque behind a mutex
+template<typename T>
+class MutexDeque
+{
+	Deque<T> deque;
+	std::mutex mutex;
+
+public:
+	void push_back(const T& value)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		deque.push_back(value);
+	}
+
+	bool try_pop_front(T& value)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (deque.empty())
+			return false;
+		value = deque.front();
+		deque.pop_front();
+		return true;
+	}
+};
+
+//one thread pushes operations integers as fast as it can and another pops them
+template<typename Queue>
+void benchmarkThroughput(const std::string& name, std::size_t operations)
+{
+	Queue queue;
+	Timer timer;
+	std::thread producer([&]()
+	{
+		for (std::size_t i = 0; i < operations; i++)
+			queue.push_back(i);
+	});
+
+	std::size_t value = 0;
+	std::size_t checksum = 0;
+	for (std::size_t received = 0; received < operations;)
+	{
+		if (queue.try_pop_front(value))
+		{
+			checksum += value;
+			received++;
+		}
+		else
+		{
+			waitForValue();
+		}
+	}
+	producer.join();
+	double seconds = timer.seconds();
+
+	doNotOptimize(checksum);
+	printResult(name + " throughput", static_cast<double>(operations), seconds);
+}
+
+//two queues bounce one value back and forth,so every round trip is two handoffs between the threads
+template<typename Queue>
+void benchmarkLatency(const std::string& name, std::size_t roundTrips)
+{
+	Queue ping;
+	Queue pong;
+	std::thread echo([&]()
+	{
+		std::size_t value = 0;
+		for (std::size_t i = 0; i < roundTrips; i++)
+		{
+			while (!ping.try_pop_front(value))
+				waitForValue();
+			pong.push_back(value);
+		}
+	});
+
+	Timer timer;
+	std::size_t value = 0;
+	for (std::size_t i = 0; i < roundTrips; i++)
+	{
+		ping.push_back(i);
+		while (!pong.try_pop_front(value))
+			waitForValue();
+	}
+	double seconds = timer.seconds();
+	echo.join();
+
+	std::cout << name << " round trip latency: " << seconds * 1e9 / static_cast<double>(roundTrips) << " ns" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t operations = argc > 1 ? std::stoull(argv[1]) : 50000000;
+	std::size_t roundTrips = argc > 2 ? std::stoull(argv[2]) : 1000000;
+
+	if (std::thread::hardware_concurrency() < 2)
+	{
+		yieldWhileWaiting = true;
+		std::cout << "only one hardware thread,the two threads share a core and the results don't show the cost of a handoff between cores" << std::endl;
+	}
+
+	benchmarkThroughput<ConcurrentSpscDeque<std::size_t>>("ConcurrentSpscDeque", operations);
+	benchmarkThroughput<MutexDeque<std::size_t>>("mutex + Deque", operations);
+	benchmarkLatency<ConcurrentSpscDeque<std::size_t>>("ConcurrentSpscDeque", roundTrips);
+	benchmarkLatency<MutexDeque<std::size_t>>("mutex + Deque", roundTrips);
+
+	return 0;
+}
@@ -0,0 +1,51 @@
+#include"../Deque/Deque.h"
+#include"BenchmarkUtils.h"
+#include<string>
+
+using CountingDeque = Deque<int, 512, std::allocator<int>, CountingDequeStats>;
+
+void printStats(const std::string& name, const DequeStats& stats)
+{
+	std::cout << name << ":" << std::endl;
+	std::cout << "  block allocations " << stats.blockAllocations << ", deallocations " << stats.blockDeallocations << ", reuses " << stats.blockReuses << ", clones " << stats.blockClones << " (" << stats.clonedElements << " elements)" << std::endl;
+	std::cout << "  directory reallocations " << stats.mapReallocations << ", re-centers " << stats.mapRecenters << ", element shifts " << stats.elementShifts << std::endl;
+	std::cout << "  " << stats.size << " elements in " << stats.usedBlocks << " blocks, " << stats.idleBlocks << " idle and " << stats.spareBlocks << " spare blocks, " << stats.mapCapacity << " directory slots" << std::endl;
+	std::cout << "  footprint " << stats.footprintBytes << " bytes for " << stats.elementBytes << " bytes of elements" << std::endl;
+}
+
+//the same FIFO and middle insert workloads with and without counting,so the cost of the counters shows up next to what they report
+template<typename DequeType>
+void benchmarkWorkload(const std::string& name, std::size_t depth, std::size_t operations, std::size_t inserts)
+{
+	DequeType deque;
+	Timer queueTimer;
+	for (std::size_t i = 0; i < depth; i++)
+		deque.push_back(static_cast<int>(i));
+	for (std::size_t i = 0; i < operations; i++)
+	{
+		deque.push_back(static_cast<int>(i));
+		deque.pop_front();
+	}
+	printResult(name + " FIFO", static_cast<double>(depth + operations), queueTimer.seconds());
+
+	DequeType snapshot(deque);
+	Timer insertTimer;
+	for (std::size_t i = 0; i < inserts; i++)
+		deque.insert(static_cast<int>(i), deque.size() / 3);
+	printResult(name + " insert after a copy", static_cast<double>(inserts), insertTimer.seconds());
+	doNotOptimize(snapshot.size());
+
+	printStats(name + " stats", deque.stats());
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t depth = argc > 1 ? std::stoull(argv[1]) : 100000;
+	std::size_t operations = argc > 2 ? std::stoull(argv[2]) : 20000000;
+	std::size_t inserts = argc > 3 ? std::stoull(argv[3]) : 1000;
+
+	benchmarkWorkload<Deque<int>>("Deque", depth, operations, inserts);
+	benchmarkWorkload<CountingDeque>("Deque with CountingDequeStats", depth, operations, inserts);
+
+	return 0;
+}
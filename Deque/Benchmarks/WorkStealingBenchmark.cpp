@@ -0,0 +1,122 @@
+#include"../Deque/WorkStealingDeque.h"
+#include"BenchmarkUtils.h"
+#include<algorithm>
+#include<atomic>
+#include<cstdint>
+#include<random>
+#include<thread>
+#include<vector>
+
+//a task sorts the part [first, last) of the shared array.It is two 32 bit indices,so the deques store it in one 64 bit atomic
+struct SortTask
+{
+	std::uint32_t first;
+	std::uint32_t last;
+};
+
+//a parallel quicksort:every worker owns a WorkStealingDeque,partitions the task it pops,keeps one half in its own deque and steals from a random other worker when it runs out.
+//The sort is finished when every element reached its final place,so no task waits for another one
+class ParallelQuicksort
+{
+	static constexpr std::uint32_t mSequentialCutoff = 2048;
+
+	std::vector<int>& values;
+	std::vector<WorkStealingDeque<SortTask>> deques;
+	std::atomic<std::size_t> unsortedCount;
+
+	void run(std::size_t worker);
+
+	void process(std::size_t worker, SortTask task);
+
+public:
+	ParallelQuicksort(std::vector<int>& values, std::size_t workerCount) : values(values), deques(workerCount), unsortedCount(values.size()) {}
+
+	void sort();
+};
+
+void ParallelQuicksort::sort()
+{
+	deques[0].push_back(SortTask{ 0, static_cast<std::uint32_t>(values.size()) });
+
+	std::vector<std::thread> threads;
+	for (std::size_t worker = 1; worker < deques.size(); worker++)
+		threads.emplace_back([this, worker]() { run(worker); });
+	run(0);
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
+void ParallelQuicksort::run(std::size_t worker)
+{
+	std::minstd_rand random(static_cast<unsigned>(worker + 1));
+	SortTask task;
+	while (unsortedCount.load(std::memory_order_acquire) > 0)
+	{
+		if (deques[worker].try_pop_back(task))
+		{
+			process(worker, task);
+			continue;
+		}
+
+		std::size_t victim = random() % deques.size();
+		if (victim != worker && deques[victim].try_steal(task))
+			process(worker, task);
+		else
+			std::this_thread::yield();
+	}
+}
+
+void ParallelQuicksort::process(std::size_t worker, SortTask task)
+{
+	while (task.last - task.first > mSequentialCutoff)  //the bigger half goes to the deque where it can be stolen,the worker goes on with the smaller one
+	{
+		int* first = values.data() + task.first;
+		int* last = values.data() + task.last;
+		int pivot = std::max(std::min(first[0], first[(last - first) / 2]), std::min(std::max(first[0], first[(last - first) / 2]), last[-1]));
+		int* middle1 = std::partition(first, last, [pivot](int value) { return value < pivot; });
+		int* middle2 = std::partition(middle1, last, [pivot](int value) { return !(pivot < value); });
+		unsortedCount.fetch_sub(static_cast<std::size_t>(middle2 - middle1), std::memory_order_release);  //the elements equal to the pivot are in place
+
+		SortTask left{ task.first, static_cast<std::uint32_t>(middle1 - values.data()) };
+		SortTask right{ static_cast<std::uint32_t>(middle2 - values.data()), task.last };
+		if (left.last - left.first < right.last - right.first)
+			std::swap(left, right);
+		deques[worker].push_back(left);
+		task = right;
+	}
+
+	std::sort(values.data() + task.first, values.data() + task.last);
+	unsortedCount.fetch_sub(task.last - task.first, std::memory_order_release);
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t elementCount = argc > 1 ? std::stoull(argv[1]) : 20000000;
+	std::size_t maxWorkers = argc > 2 ? std::stoull(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+
+	std::vector<int> input(elementCount);
+	std::mt19937 random(42);
+	for (int& value : input)
+		value = static_cast<int>(random());
+
+	std::vector<int> expected = input;
+	Timer sortTimer;
+	std::sort(expected.begin(), expected.end());
+	double sequentialSeconds = sortTimer.seconds();
+	std::cout << "std::sort: " << sequentialSeconds * 1e3 << " ms" << std::endl;
+
+	for (std::size_t workers = 1; workers <= maxWorkers; workers *= 2)
+	{
+		std::vector<int> values = input;
+		ParallelQuicksort quicksort(values, workers);
+		Timer timer;
+		quicksort.sort();
+		double seconds = timer.seconds();
+
+		std::cout << "work-stealing quicksort with " << workers << " workers: " << seconds * 1e3 << " ms, speedup over std::sort " << sequentialSeconds / seconds << (values == expected ? "" : " WRONG RESULT") << std::endl;
+		if (workers < maxWorkers && workers * 2 > maxWorkers)
+			workers = maxWorkers / 2;  //the last step uses all the workers even if their number isn't a power of two
+	}
+
+	return 0;
+}
@@ -0,0 +1,184 @@
+#pragma once
+#include<cstddef>
+#include<new>
+
+//a per-thread cache of freed memory chunks grouped by size.Deques that use PoolAllocator share it,so the blocks released by one deque are reused by the next deque created on the same thread instead of going back to the global allocator
+class BlockPool
+{
+	static constexpr std::size_t mMaxSizeClasses = 8;
+	static constexpr std::size_t mMaxArraySizeClasses = 4;  //arrays like the block directory take a new size every time they grow,so they may only take half of the size classes and the rest stays free for the blocks
+	static constexpr std::size_t mMaxChunksPerSizeClass = 64;
+
+	struct FreeChunk
+	{
+		FreeChunk* next;
+	};
+
+	struct SizeClass
+	{
+		std::size_t bytes;
+		std::size_t alignment;
+		FreeChunk* head;
+		std::size_t chunkCount;
+	};
+
+	SizeClass sizeClasses[mMaxSizeClasses];
+	std::size_t sizeClassCount;
+	std::size_t arraySizeClassCount;
+
+	BlockPool() : sizeClasses(), sizeClassCount(0), arraySizeClassCount(0) {}
+
+	SizeClass* findSizeClass(std::size_t bytes, std::size_t alignment, bool isArray);
+
+	static bool isPoolable(std::size_t bytes);
+
+	static void* allocateChunk(std::size_t bytes, std::size_t alignment);
+
+	static void deallocateChunk(void* pointer, std::size_t alignment);
+
+public:
+	BlockPool(const BlockPool&) = delete;
+	BlockPool& operator=(const BlockPool&) = delete;
+
+	~BlockPool();
+
+	static BlockPool& threadLocalInstance();
+
+	void* allocate(std::size_t bytes, std::size_t alignment, bool isArray = false);
+
+	void deallocate(void* pointer, std::size_t bytes, std::size_t alignment, bool isArray = false);
+
+	void release();
+};
+
+//an allocator that takes its memory from the thread-local BlockPool.Used as the Allocator parameter of Deque,it makes the blocks of all the deques of a thread come from the same pool.A deque using it must be destroyed before the thread that created it exits
+template<typename T>
+class PoolAllocator
+{
+public:
+	using value_type = T;
+
+	PoolAllocator() noexcept {}
+
+	template<typename U>
+	PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+	T* allocate(std::size_t count);
+
+	void deallocate(T* pointer, std::size_t count);
+
+	template<typename U>
+	bool operator==(const PoolAllocator<U>&) const noexcept { return true; }
+
+	template<typename U>
+	bool operator!=(const PoolAllocator<U>&) const noexcept { return false; }
+};
+
+inline BlockPool::~BlockPool()
+{
+	release();
+}
+
+inline BlockPool& BlockPool::threadLocalInstance()
+{
+	thread_local BlockPool pool;
+	return pool;
+}
+
+inline bool BlockPool::isPoolable(std::size_t bytes)
+{
+	return bytes >= sizeof(FreeChunk);
+}
+
+//over-aligned chunks,like the cache line aligned blocks of a deque,come from the aligned operator new and have their own size class,so a chunk is always freed the way it was allocated
+inline void* BlockPool::allocateChunk(std::size_t bytes, std::size_t alignment)
+{
+	if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+		return ::operator new(bytes, std::align_val_t(alignment));
+	return ::operator new(bytes);
+}
+
+inline void BlockPool::deallocateChunk(void* pointer, std::size_t alignment)
+{
+	if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+		::operator delete(pointer, std::align_val_t(alignment));
+	else
+		::operator delete(pointer);
+}
+
+inline BlockPool::SizeClass* BlockPool::findSizeClass(std::size_t bytes, std::size_t alignment, bool isArray)
+{
+	alignment = alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__ ? alignment : 0;  //all the alignments operator new gives anyway share a size class
+	for (std::size_t i = 0; i < sizeClassCount; i++)
+		if (sizeClasses[i].bytes == bytes && sizeClasses[i].alignment == alignment)
+			return &sizeClasses[i];
+
+	if (sizeClassCount == mMaxSizeClasses || (isArray && arraySizeClassCount == mMaxArraySizeClasses))  //when every size class is taken,the chunks of this size are not cached
+		return nullptr;
+
+	if (isArray)
+		arraySizeClassCount++;
+	sizeClasses[sizeClassCount] = SizeClass{ bytes, alignment, nullptr, 0 };
+	return &sizeClasses[sizeClassCount++];
+}
+
+inline void* BlockPool::allocate(std::size_t bytes, std::size_t alignment, bool isArray)
+{
+	if (!isPoolable(bytes))
+		return allocateChunk(bytes, alignment);
+
+	SizeClass* sizeClass = findSizeClass(bytes, alignment, isArray);
+	if (sizeClass == nullptr || sizeClass->head == nullptr)
+		return allocateChunk(bytes, alignment);
+
+	FreeChunk* chunk = sizeClass->head;
+	sizeClass->head = chunk->next;
+	sizeClass->chunkCount--;
+	return chunk;
+}
+
+inline void BlockPool::deallocate(void* pointer, std::size_t bytes, std::size_t alignment, bool isArray)
+{
+	if (!isPoolable(bytes))
+	{
+		deallocateChunk(pointer, alignment);
+		return;
+	}
+
+	SizeClass* sizeClass = findSizeClass(bytes, alignment, isArray);
+	if (sizeClass == nullptr || sizeClass->chunkCount == mMaxChunksPerSizeClass)
+	{
+		deallocateChunk(pointer, alignment);
+		return;
+	}
+
+	FreeChunk* chunk = ::new(pointer) FreeChunk{ sizeClass->head };
+	sizeClass->head = chunk;
+	sizeClass->chunkCount++;
+}
+
+inline void BlockPool::release()
+{
+	for (std::size_t i = 0; i < sizeClassCount; i++)
+	{
+		while (sizeClasses[i].head != nullptr)
+		{
+			FreeChunk* chunk = sizeClasses[i].head;
+			sizeClasses[i].head = chunk->next;
+			deallocateChunk(chunk, sizeClasses[i].alignment);
+		}
+		sizeClasses[i].chunkCount = 0;
+	}
+}
+
+template<typename T>
+T* PoolAllocator<T>::allocate(std::size_t count)
+{
+	return static_cast<T*>(BlockPool::threadLocalInstance().allocate(count * sizeof(T), alignof(T), count != 1));
+}
+
+template<typename T>
+void PoolAllocator<T>::deallocate(T* pointer, std::size_t count)
+{
+	BlockPool::threadLocalInstance().deallocate(pointer, count * sizeof(T), alignof(T), count != 1);
+}
@@ -0,0 +1,777 @@
+#pragma once
+#include"Deque.h"
+#include<cstddef>
+#include<iterator>
+#include<memory>
+#include<new>
+#include<stdexcept>
+#include<type_traits>
+#include<utility>
+
+//what push_back and push_front do when the deque is full:Reject leaves the deque unchanged and returns false,Overwrite drops the element at the other end to make room
+enum class BoundedPolicy
+{
+	Reject,
+	Overwrite
+};
+
+//a deque with a fixed capacity.All its blocks are allocated by the constructor and used as a ring,so pushing and popping never allocate or free memory.The interface is the one of Deque apart from the pushes,which report if the element was added
+template<typename T, BoundedPolicy Policy = BoundedPolicy::Reject, std::size_t BlockBytes = 512, typename Allocator = std::allocator<T>>
+class BoundedDeque
+{
+	static constexpr std::size_t mBlockSize = sizeof(T) < BlockBytes ? BlockBytes / sizeof(T) : 1;
+	static constexpr bool mBlockSizeIsPowerOfTwo = (mBlockSize & (mBlockSize - 1)) == 0;
+	static constexpr std::size_t mBlockShift = mBlockSizeIsPowerOfTwo ? dequeLog2(mBlockSize) : 0;
+
+	struct Block
+	{
+		alignas(T) unsigned char storage[sizeof(T) * mBlockSize];
+
+		T* data() { return std::launder(reinterpret_cast<T*>(storage)); }
+	};
+
+	using AllocatorTraits = std::allocator_traits<Allocator>;
+	using BlockAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Block>;
+	using MapAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Block*>;
+	using BlockAllocatorTraits = std::allocator_traits<BlockAllocator>;
+	using MapAllocatorTraits = std::allocator_traits<MapAllocator>;
+
+	Allocator allocator;
+
+	//the ring has blockCount * mBlockSize slots,at least maxSize of them.The element at index i is in slot (head + i) mod ringCapacity
+	Block** blocks;
+	std::size_t blockCount;
+	std::size_t ringCapacity;
+	std::size_t maxSize;
+	std::size_t head;
+	std::size_t count;
+
+	void allocateRing(std::size_t capacity);
+
+	void releaseRing();
+
+	T* slotAddress(std::size_t slot) const;
+
+	T* elementAddress(std::size_t index) const;
+
+public:
+	//an iterator is a position counted from the front,so it stays at the same index when the ring wraps around
+	template<bool IsConst>
+	class BasicIterator
+	{
+		friend class BoundedDeque;
+		friend class BasicIterator<!IsConst>;
+
+		using DequePointer = std::conditional_t<IsConst, const BoundedDeque*, BoundedDeque*>;
+
+		DequePointer deque;
+		std::size_t index;
+
+		BasicIterator(DequePointer deque, std::size_t index) : deque(deque), index(index) {}
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using iterator_concept = std::random_access_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<IsConst, const T*, T*>;
+		using reference = std::conditional_t<IsConst, const T&, T&>;
+
+		BasicIterator() : deque(nullptr), index(0) {}
+
+		template<bool OtherIsConst, typename = std::enable_if_t<IsConst && !OtherIsConst>>
+		BasicIterator(const BasicIterator<OtherIsConst>& other) : deque(other.deque), index(other.index) {}
+
+		reference operator*() const;
+		pointer operator->() const;
+		reference operator[](difference_type steps) const;
+		BasicIterator& operator++();
+		BasicIterator& operator--();
+		BasicIterator operator++(int);
+		BasicIterator operator--(int);
+		BasicIterator& operator+=(difference_type steps);
+		BasicIterator& operator-=(difference_type steps);
+		BasicIterator operator+(difference_type steps) const;
+		BasicIterator operator-(difference_type steps) const;
+
+		template<bool OtherIsConst>
+		difference_type operator-(const BasicIterator<OtherIsConst>& other) const;
+
+		template<bool OtherIsConst>
+		bool operator==(const BasicIterator<OtherIsConst>& other) const;
+
+		template<bool OtherIsConst>
+		bool operator!=(const BasicIterator<OtherIsConst>& other) const;
+
+		template<bool OtherIsConst>
+		bool operator<(const BasicIterator<OtherIsConst>& other) const;
+
+		template<bool OtherIsConst>
+		bool operator>(const BasicIterator<OtherIsConst>& other) const;
+
+		template<bool OtherIsConst>
+		bool operator<=(const BasicIterator<OtherIsConst>& other) const;
+
+		template<bool OtherIsConst>
+		bool operator>=(const BasicIterator<OtherIsConst>& other) const;
+
+		friend BasicIterator operator+(difference_type steps, const BasicIterator& it) { return it + steps; }
+	};
+
+	using Iterator = BasicIterator<false>;
+	using ConstIterator = BasicIterator<true>;
+
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = T&;
+	using const_reference = const T&;
+	using iterator = Iterator;
+	using const_iterator = ConstIterator;
+	using reverse_iterator = std::reverse_iterator<Iterator>;
+	using const_reverse_iterator = std::reverse_iterator<ConstIterator>;
+	using allocator_type = Allocator;
+
+	explicit BoundedDeque(std::size_t capacity, const Allocator& allocator = Allocator());
+
+	BoundedDeque(const BoundedDeque& other);
+
+	BoundedDeque(BoundedDeque&& other) noexcept;
+
+	~BoundedDeque();
+
+	BoundedDeque& operator=(const BoundedDeque& other);
+
+	BoundedDeque& operator=(BoundedDeque&& other) noexcept(std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value || std::allocator_traits<Allocator>::is_always_equal::value);
+
+	bool push_back(const T& value);
+
+	bool push_back(T&& value);
+
+	bool push_front(const T& value);
+
+	bool push_front(T&& value);
+
+	template<typename... Args>
+	bool emplace_back(Args&&... args);
+
+	template<typename... Args>
+	bool emplace_front(Args&&... args);
+
+	void pop_back();
+
+	void pop_front();
+
+	T& front();
+
+	const T& front() const;
+
+	T& back();
+
+	const T& back() const;
+
+	T& operator[](std::size_t index);
+
+	const T& operator[](std::size_t index) const;
+
+	bool empty() const;
+
+	bool full() const;
+
+	void clear();
+
+	std::size_t size() const;
+
+	std::size_t capacity() const;
+
+	Iterator begin();
+
+	Iterator end();
+
+	ConstIterator begin() const;
+
+	ConstIterator end() const;
+
+	ConstIterator cbegin() const;
+
+	ConstIterator cend() const;
+
+	reverse_iterator rbegin();
+
+	reverse_iterator rend();
+
+	const_reverse_iterator rbegin() const;
+
+	const_reverse_iterator rend() const;
+
+	Allocator get_allocator() const;
+};
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+BoundedDeque<T, Policy, BlockBytes, Allocator>::BoundedDeque(std::size_t capacity, const Allocator& allocator) : allocator(allocator), blocks(nullptr), blockCount(0), ringCapacity(0), maxSize(0), head(0), count(0)
+{
+	allocateRing(capacity);
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+BoundedDeque<T, Policy, BlockBytes, Allocator>::BoundedDeque(const BoundedDeque& other) : BoundedDeque(other.maxSize, std::allocator_traits<Allocator>::select_on_container_copy_construction(other.allocator))
+{
+	for (std::size_t i = 0; i < other.count; i++)
+		emplace_back(*other.elementAddress(i));
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+BoundedDeque<T, Policy, BlockBytes, Allocator>::BoundedDeque(BoundedDeque&& other) noexcept : allocator(std::move(other.allocator)), blocks(other.blocks), blockCount(other.blockCount), ringCapacity(other.ringCapacity), maxSize(other.maxSize), head(other.head), count(other.count)
+{
+	other.blocks = nullptr;  //the moved from deque has no ring left,it can only be destroyed or assigned to
+	other.blockCount = 0;
+	other.ringCapacity = 0;
+	other.maxSize = 0;
+	other.head = 0;
+	other.count = 0;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+BoundedDeque<T, Policy, BlockBytes, Allocator>::~BoundedDeque()
+{
+	clear();
+	releaseRing();
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+BoundedDeque<T, Policy, BlockBytes, Allocator>& BoundedDeque<T, Policy, BlockBytes, Allocator>::operator=(const BoundedDeque& other)
+{
+	if (this == &other)  //prevent self-assignment
+		return *this;
+
+	clear();
+	if constexpr (AllocatorTraits::propagate_on_container_copy_assignment::value)
+	{
+		if (allocator != other.allocator)  //the ring has to be released with the allocator that made it
+			releaseRing();
+		allocator = other.allocator;
+	}
+
+	if (maxSize != other.maxSize)  //the ring is only allocated again if the capacity changes
+	{
+		releaseRing();
+		allocateRing(other.maxSize);
+	}
+
+	for (std::size_t i = 0; i < other.count; i++)
+		emplace_back(*other.elementAddress(i));
+
+	return *this;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+BoundedDeque<T, Policy, BlockBytes, Allocator>& BoundedDeque<T, Policy, BlockBytes, Allocator>::operator=(BoundedDeque&& other) noexcept(std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value || std::allocator_traits<Allocator>::is_always_equal::value)
+{
+	if (this == &other)
+		return *this;
+
+	clear();
+	if constexpr (!AllocatorTraits::propagate_on_container_move_assignment::value && !AllocatorTraits::is_always_equal::value)
+	{
+		if (allocator != other.allocator)  //the ring can only be taken over if this allocator is able to free it,otherwise the elements are moved one by one
+		{
+			if (maxSize != other.maxSize)
+			{
+				releaseRing();
+				allocateRing(other.maxSize);
+			}
+			for (std::size_t i = 0; i < other.count; i++)
+				emplace_back(std::move(*other.elementAddress(i)));
+			other.clear();
+			return *this;
+		}
+	}
+
+	std::swap(blocks, other.blocks);  //the old ring of this deque goes to the other one,which releases it
+	std::swap(blockCount, other.blockCount);
+	std::swap(ringCapacity, other.ringCapacity);
+	std::swap(maxSize, other.maxSize);
+	std::swap(head, other.head);
+	std::swap(count, other.count);
+	if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value)
+		std::swap(allocator, other.allocator);
+
+	return *this;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+void BoundedDeque<T, Policy, BlockBytes, Allocator>::allocateRing(std::size_t capacity)
+{
+	if (capacity == 0)
+		throw std::invalid_argument("BoundedDeque capacity must be at least 1");
+
+	std::size_t newBlockCount = (capacity + mBlockSize - 1) / mBlockSize;
+	MapAllocator mapAllocator(allocator);
+	BlockAllocator blockAllocator(allocator);
+	Block** newBlocks = MapAllocatorTraits::allocate(mapAllocator, newBlockCount);
+	std::size_t allocated = 0;
+	try
+	{
+		for (; allocated < newBlockCount; allocated++)
+			newBlocks[allocated] = BlockAllocatorTraits::allocate(blockAllocator, 1);
+	}
+	catch (...)
+	{
+		while (allocated > 0)
+			BlockAllocatorTraits::deallocate(blockAllocator, newBlocks[--allocated], 1);
+		MapAllocatorTraits::deallocate(mapAllocator, newBlocks, newBlockCount);
+		throw;
+	}
+
+	blocks = newBlocks;
+	blockCount = newBlockCount;
+	ringCapacity = newBlockCount * mBlockSize;
+	maxSize = capacity;
+	head = 0;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+void BoundedDeque<T, Policy, BlockBytes, Allocator>::releaseRing()
+{
+	if (blocks != nullptr)
+	{
+		MapAllocator mapAllocator(allocator);
+		BlockAllocator blockAllocator(allocator);
+		for (std::size_t i = 0; i < blockCount; i++)
+			BlockAllocatorTraits::deallocate(blockAllocator, blocks[i], 1);
+		MapAllocatorTraits::deallocate(mapAllocator, blocks, blockCount);
+	}
+
+	blocks = nullptr;
+	blockCount = 0;
+	ringCapacity = 0;
+	maxSize = 0;
+	head = 0;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+T* BoundedDeque<T, Policy, BlockBytes, Allocator>::slotAddress(std::size_t slot) const
+{
+	if constexpr (mBlockSizeIsPowerOfTwo)
+		return blocks[slot >> mBlockShift]->data() + (slot & (mBlockSize - 1));
+	else
+		return blocks[slot / mBlockSize]->data() + slot % mBlockSize;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+T* BoundedDeque<T, Policy, BlockBytes, Allocator>::elementAddress(std::size_t index) const
+{
+	std::size_t slot = head + index;  //head and index are both below ringCapacity,so one subtraction wraps the slot around
+	if (slot >= ringCapacity)
+		slot -= ringCapacity;
+	return slotAddress(slot);
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+bool BoundedDeque<T, Policy, BlockBytes, Allocator>::push_back(const T& value)
+{
+	return emplace_back(value);
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+bool BoundedDeque<T, Policy, BlockBytes, Allocator>::push_back(T&& value)
+{
+	return emplace_back(std::move(value));
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+bool BoundedDeque<T, Policy, BlockBytes, Allocator>::push_front(const T& value)
+{
+	return emplace_front(value);
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+bool BoundedDeque<T, Policy, BlockBytes, Allocator>::push_front(T&& value)
+{
+	return emplace_front(std::move(value));
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+template<typename... Args>
+bool BoundedDeque<T, Policy, BlockBytes, Allocator>::emplace_back(Args&&... args)
+{
+	if (count == maxSize)
+	{
+		if constexpr (Policy == BoundedPolicy::Reject)
+			return false;
+		else
+		{
+			T value(std::forward<Args>(args)...);  //the arguments may refer to the element that is evicted,so the new element is made before it is destroyed
+			pop_front();  //the oldest element makes room for the new one
+			AllocatorTraits::construct(allocator, elementAddress(count), std::move(value));
+			count++;
+			return true;
+		}
+	}
+
+	AllocatorTraits::construct(allocator, elementAddress(count), std::forward<Args>(args)...);
+	count++;
+	return true;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+template<typename... Args>
+bool BoundedDeque<T, Policy, BlockBytes, Allocator>::emplace_front(Args&&... args)
+{
+	if (count == maxSize)
+	{
+		if constexpr (Policy == BoundedPolicy::Reject)
+			return false;
+		else
+		{
+			T value(std::forward<Args>(args)...);  //the arguments may refer to the element that is evicted,so the new element is made before it is destroyed
+			pop_back();  //seen from the front,the oldest element is the last one
+			std::size_t newHead = head == 0 ? ringCapacity - 1 : head - 1;
+			AllocatorTraits::construct(allocator, slotAddress(newHead), std::move(value));
+			head = newHead;
+			count++;
+			return true;
+		}
+	}
+
+	std::size_t newHead = head == 0 ? ringCapacity - 1 : head - 1;
+	AllocatorTraits::construct(allocator, slotAddress(newHead), std::forward<Args>(args)...);
+	head = newHead;
+	count++;
+	return true;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+void BoundedDeque<T, Policy, BlockBytes, Allocator>::pop_back()
+{
+	if (empty())
+		return;
+
+	AllocatorTraits::destroy(allocator, elementAddress(count - 1));
+	count--;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+void BoundedDeque<T, Policy, BlockBytes, Allocator>::pop_front()
+{
+	if (empty())
+		return;
+
+	AllocatorTraits::destroy(allocator, elementAddress(0));
+	head = head + 1 == ringCapacity ? 0 : head + 1;
+	count--;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+T& BoundedDeque<T, Policy, BlockBytes, Allocator>::front()
+{
+	if (empty())
+		throw std::out_of_range("Deque is empty, cannot access front element.");
+
+	return *elementAddress(0);
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+const T& BoundedDeque<T, Policy, BlockBytes, Allocator>::front() const
+{
+	if (empty())
+		throw std::out_of_range("Deque is empty, cannot access front element.");
+
+	return *elementAddress(0);
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+T& BoundedDeque<T, Policy, BlockBytes, Allocator>::back()
+{
+	if (empty())
+		throw std::out_of_range("Deque is empty, cannot access back element.");
+
+	return *elementAddress(count - 1);
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+const T& BoundedDeque<T, Policy, BlockBytes, Allocator>::back() const
+{
+	if (empty())
+		throw std::out_of_range("Deque is empty, cannot access back element.");
+
+	return *elementAddress(count - 1);
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+T& BoundedDeque<T, Policy, BlockBytes, Allocator>::operator[](std::size_t index)
+{
+	if (index >= count)
+	{
+		if (count == 0)  //either the deque is empty
+		{
+			throw std::out_of_range("Trying to access empty deque");
+		}
+		else  //or the index is out of range
+		{
+			clear();
+			throw std::out_of_range("Index out of range");
+		}
+	}
+
+	return *elementAddress(index);
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+const T& BoundedDeque<T, Policy, BlockBytes, Allocator>::operator[](std::size_t index) const
+{
+	if (index >= count)
+		throw std::out_of_range(count == 0 ? "Trying to access empty deque" : "Index out of range");
+
+	return *elementAddress(index);
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+bool BoundedDeque<T, Policy, BlockBytes, Allocator>::empty() const
+{
+	return count == 0;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+bool BoundedDeque<T, Policy, BlockBytes, Allocator>::full() const
+{
+	return count == maxSize;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+void BoundedDeque<T, Policy, BlockBytes, Allocator>::clear()
+{
+	if constexpr (!std::is_trivially_destructible_v<T>)
+	{
+		for (std::size_t i = 0; i < count; i++)
+			AllocatorTraits::destroy(allocator, elementAddress(i));
+	}
+
+	head = 0;
+	count = 0;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+std::size_t BoundedDeque<T, Policy, BlockBytes, Allocator>::size() const
+{
+	return count;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+std::size_t BoundedDeque<T, Policy, BlockBytes, Allocator>::capacity() const
+{
+	return maxSize;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+Allocator BoundedDeque<T, Policy, BlockBytes, Allocator>::get_allocator() const
+{
+	return allocator;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::Iterator BoundedDeque<T, Policy, BlockBytes, Allocator>::begin()
+{
+	return Iterator(this, 0);
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::Iterator BoundedDeque<T, Policy, BlockBytes, Allocator>::end()
+{
+	return Iterator(this, count);
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::ConstIterator BoundedDeque<T, Policy, BlockBytes, Allocator>::begin() const
+{
+	return ConstIterator(this, 0);
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::ConstIterator BoundedDeque<T, Policy, BlockBytes, Allocator>::end() const
+{
+	return ConstIterator(this, count);
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::ConstIterator BoundedDeque<T, Policy, BlockBytes, Allocator>::cbegin() const
+{
+	return begin();
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::ConstIterator BoundedDeque<T, Policy, BlockBytes, Allocator>::cend() const
+{
+	return end();
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::reverse_iterator BoundedDeque<T, Policy, BlockBytes, Allocator>::rbegin()
+{
+	return reverse_iterator(end());
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::reverse_iterator BoundedDeque<T, Policy, BlockBytes, Allocator>::rend()
+{
+	return reverse_iterator(begin());
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::const_reverse_iterator BoundedDeque<T, Policy, BlockBytes, Allocator>::rbegin() const
+{
+	return const_reverse_iterator(end());
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::const_reverse_iterator BoundedDeque<T, Policy, BlockBytes, Allocator>::rend() const
+{
+	return const_reverse_iterator(begin());
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::template BasicIterator<IsConst>::reference BoundedDeque<T, Policy, BlockBytes, Allocator>::BasicIterator<IsConst>::operator*() const
+{
+	return *deque->elementAddress(index);
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::template BasicIterator<IsConst>::pointer BoundedDeque<T, Policy, BlockBytes, Allocator>::BasicIterator<IsConst>::operator->() const
+{
+	return deque->elementAddress(index);
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::template BasicIterator<IsConst>::reference BoundedDeque<T, Policy, BlockBytes, Allocator>::BasicIterator<IsConst>::operator[](difference_type steps) const
+{
+	return *deque->elementAddress(index + steps);
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::template BasicIterator<IsConst>& BoundedDeque<T, Policy, BlockBytes, Allocator>::BasicIterator<IsConst>::operator++()
+{
+	++index;
+
+	return *this;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::template BasicIterator<IsConst>& BoundedDeque<T, Policy, BlockBytes, Allocator>::BasicIterator<IsConst>::operator--()
+{
+	--index;
+
+	return *this;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::template BasicIterator<IsConst> BoundedDeque<T, Policy, BlockBytes, Allocator>::BasicIterator<IsConst>::operator++(int)
+{
+	BasicIterator temp = *this;
+	++index;
+
+	return temp;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::template BasicIterator<IsConst> BoundedDeque<T, Policy, BlockBytes, Allocator>::BasicIterator<IsConst>::operator--(int)
+{
+	BasicIterator temp = *this;
+	--index;
+
+	return temp;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::template BasicIterator<IsConst>& BoundedDeque<T, Policy, BlockBytes, Allocator>::BasicIterator<IsConst>::operator+=(difference_type steps)
+{
+	index += steps;
+
+	return *this;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::template BasicIterator<IsConst>& BoundedDeque<T, Policy, BlockBytes, Allocator>::BasicIterator<IsConst>::operator-=(difference_type steps)
+{
+	index -= steps;
+
+	return *this;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::template BasicIterator<IsConst> BoundedDeque<T, Policy, BlockBytes, Allocator>::BasicIterator<IsConst>::operator+(difference_type steps) const
+{
+	return BasicIterator(deque, index + steps);
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::template BasicIterator<IsConst> BoundedDeque<T, Policy, BlockBytes, Allocator>::BasicIterator<IsConst>::operator-(difference_type steps) const
+{
+	return BasicIterator(deque, index - steps);
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+template<bool OtherIsConst>
+typename BoundedDeque<T, Policy, BlockBytes, Allocator>::template BasicIterator<IsConst>::difference_type BoundedDeque<T, Policy, BlockBytes, Allocator>::BasicIterator<IsConst>::operator-(const BasicIterator<OtherIsConst>& other) const
+{
+	return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+template<bool OtherIsConst>
+bool BoundedDeque<T, Policy, BlockBytes, Allocator>::BasicIterator<IsConst>::operator==(const BasicIterator<OtherIsConst>& other) const
+{
+	return index == other.index;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+template<bool OtherIsConst>
+bool BoundedDeque<T, Policy, BlockBytes, Allocator>::BasicIterator<IsConst>::operator!=(const BasicIterator<OtherIsConst>& other) const
+{
+	return index != other.index;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+template<bool OtherIsConst>
+bool BoundedDeque<T, Policy, BlockBytes, Allocator>::BasicIterator<IsConst>::operator<(const BasicIterator<OtherIsConst>& other) const
+{
+	return index < other.index;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+template<bool OtherIsConst>
+bool BoundedDeque<T, Policy, BlockBytes, Allocator>::BasicIterator<IsConst>::operator>(const BasicIterator<OtherIsConst>& other) const
+{
+	return index > other.index;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+template<bool OtherIsConst>
+bool BoundedDeque<T, Policy, BlockBytes, Allocator>::BasicIterator<IsConst>::operator<=(const BasicIterator<OtherIsConst>& other) const
+{
+	return index <= other.index;
+}
+
+template<typename T, BoundedPolicy Policy, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+template<bool OtherIsConst>
+bool BoundedDeque<T, Policy, BlockBytes, Allocator>::BasicIterator<IsConst>::operator>=(const BasicIterator<OtherIsConst>& other) const
+{
+	return index >= other.index;
+}
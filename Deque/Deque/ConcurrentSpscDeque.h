@@ -0,0 +1,233 @@
+#pragma once
+#include<atomic>
+#include<cstddef>
+#include<memory>
+#include<new>
+#include<type_traits>
+#include<utility>
+
+//an unbounded lock-free queue for exactly one producer thread and one consumer thread.The elements are stored in a chain of blocks like in Deque:the producer constructs at the tail,the consumer destroys at the head,and a block the consumer has left is reused by the producer instead of being freed
+template<typename T, std::size_t BlockBytes = 512, typename Allocator = std::allocator<T>>
+class ConcurrentSpscDeque
+{
+	static constexpr std::size_t mBlockSize = sizeof(T) < BlockBytes ? BlockBytes / sizeof(T) : 1;
+	static constexpr std::size_t mCacheLineSize = 64;
+
+	//next is a plain pointer:the producer writes it before it publishes the first element of the next block,and the consumer reads it before it publishes that it popped the last element of this block
+	struct Block
+	{
+		alignas(T) unsigned char storage[sizeof(T) * mBlockSize];
+		Block* next;
+
+		T* data() { return std::launder(reinterpret_cast<T*>(storage)); }
+	};
+
+	using AllocatorTraits = std::allocator_traits<Allocator>;
+	using BlockAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Block>;
+	using BlockAllocatorTraits = std::allocator_traits<BlockAllocator>;
+
+	Allocator allocator;
+
+	//the producer side.The blocks form one chain from oldestBlock to tailBlock,oldestBlock is the next candidate for reuse and oldestBlockEnd is the number of elements that were pushed before the end of it
+	alignas(mCacheLineSize) Block* tailBlock;
+	std::size_t tailIndex;
+	std::size_t pushCount;
+	Block* oldestBlock;
+	std::size_t oldestBlockEnd;
+	std::size_t cachedPopCount;  //the last value of popped the producer read,so it only touches the consumer's cache line when it needs a block
+
+	alignas(mCacheLineSize) std::atomic<std::size_t> pushed;
+
+	//the consumer side
+	alignas(mCacheLineSize) Block* headBlock;
+	std::size_t headIndex;
+	std::size_t popCount;
+	std::size_t cachedPushCount;  //the last value of pushed the consumer read,so it only touches the producer's cache line when it seems to have caught up
+
+	alignas(mCacheLineSize) std::atomic<std::size_t> popped;
+
+	Block* allocateBlock();
+
+	Block* acquireBlock();
+
+public:
+	using value_type = T;
+	using allocator_type = Allocator;
+
+	ConcurrentSpscDeque();
+
+	explicit ConcurrentSpscDeque(const Allocator& allocator);
+
+	ConcurrentSpscDeque(const ConcurrentSpscDeque&) = delete;
+
+	ConcurrentSpscDeque& operator=(const ConcurrentSpscDeque&) = delete;
+
+	~ConcurrentSpscDeque();
+
+	//producer thread only
+	void push_back(const T& value);
+
+	void push_back(T&& value);
+
+	template<typename... Args>
+	void emplace_back(Args&&... args);
+
+	//consumer thread only.Moves the first element into value and returns true,or returns false if the queue is empty
+	bool try_pop_front(T& value);
+
+	//consumer thread only.Returns the first element without removing it,or nullptr if the queue is empty
+	T* front();
+
+	//can be called from either thread,the result may be out of date as soon as it is returned
+	bool empty() const;
+
+	std::size_t size() const;
+
+	Allocator get_allocator() const;
+};
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+ConcurrentSpscDeque<T, BlockBytes, Allocator>::ConcurrentSpscDeque() : ConcurrentSpscDeque(Allocator()) {}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+ConcurrentSpscDeque<T, BlockBytes, Allocator>::ConcurrentSpscDeque(const Allocator& allocator) : allocator(allocator), tailBlock(nullptr), tailIndex(0), pushCount(0), oldestBlock(nullptr), oldestBlockEnd(mBlockSize), cachedPopCount(0), pushed(0), headBlock(nullptr), headIndex(0), popCount(0), cachedPushCount(0), popped(0)
+{
+	tailBlock = allocateBlock();  //the queue always has a block,so neither thread has to handle an empty chain
+	headBlock = tailBlock;
+	oldestBlock = tailBlock;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+ConcurrentSpscDeque<T, BlockBytes, Allocator>::~ConcurrentSpscDeque()
+{
+	std::size_t remaining = pushed.load(std::memory_order_acquire) - popped.load(std::memory_order_acquire);
+	Block* block = headBlock;
+	std::size_t index = headIndex;
+	for (std::size_t i = 0; i < remaining; i++)
+	{
+		if (index == mBlockSize)
+		{
+			block = block->next;
+			index = 0;
+		}
+		AllocatorTraits::destroy(allocator, block->data() + index);
+		index++;
+	}
+
+	BlockAllocator blockAllocator(allocator);
+	while (oldestBlock != nullptr)
+	{
+		Block* next = oldestBlock->next;
+		BlockAllocatorTraits::deallocate(blockAllocator, oldestBlock, 1);
+		oldestBlock = next;
+	}
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+typename ConcurrentSpscDeque<T, BlockBytes, Allocator>::Block* ConcurrentSpscDeque<T, BlockBytes, Allocator>::allocateBlock()
+{
+	BlockAllocator blockAllocator(allocator);
+	Block* block = BlockAllocatorTraits::allocate(blockAllocator, 1);
+	block->next = nullptr;
+	return block;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+typename ConcurrentSpscDeque<T, BlockBytes, Allocator>::Block* ConcurrentSpscDeque<T, BlockBytes, Allocator>::acquireBlock()
+{
+	//the consumer reads the next pointer of the oldest block when it pops the element right after the end of that block,so the block is only free once more elements than that were popped
+	if (cachedPopCount <= oldestBlockEnd)
+		cachedPopCount = popped.load(std::memory_order_acquire);
+
+	if (cachedPopCount > oldestBlockEnd)
+	{
+		Block* block = oldestBlock;
+		oldestBlock = oldestBlock->next;
+		oldestBlockEnd += mBlockSize;
+		block->next = nullptr;
+		return block;
+	}
+
+	return allocateBlock();
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+void ConcurrentSpscDeque<T, BlockBytes, Allocator>::push_back(const T& value)
+{
+	emplace_back(value);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+void ConcurrentSpscDeque<T, BlockBytes, Allocator>::push_back(T&& value)
+{
+	emplace_back(std::move(value));
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+template<typename... Args>
+void ConcurrentSpscDeque<T, BlockBytes, Allocator>::emplace_back(Args&&... args)
+{
+	if (tailIndex == mBlockSize)  //the tail block is full,a reused or new block is linked after it before the element is published
+	{
+		Block* block = acquireBlock();
+		tailBlock->next = block;
+		tailBlock = block;
+		tailIndex = 0;
+	}
+
+	AllocatorTraits::construct(allocator, tailBlock->data() + tailIndex, std::forward<Args>(args)...);
+	tailIndex++;
+	pushed.store(++pushCount, std::memory_order_release);  //the release makes the element and the link to its block visible to the consumer
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+bool ConcurrentSpscDeque<T, BlockBytes, Allocator>::try_pop_front(T& value)
+{
+	T* element = front();
+	if (element == nullptr)
+		return false;
+
+	value = std::move(*element);
+	AllocatorTraits::destroy(allocator, element);
+	headIndex++;
+	popped.store(++popCount, std::memory_order_release);  //the release tells the producer the slot and everything before it can be reused
+	return true;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+T* ConcurrentSpscDeque<T, BlockBytes, Allocator>::front()
+{
+	if (popCount == cachedPushCount)
+	{
+		cachedPushCount = pushed.load(std::memory_order_acquire);
+		if (popCount == cachedPushCount)
+			return nullptr;
+	}
+
+	if (headIndex == mBlockSize)  //the head block was consumed,the element is the first one of the next block
+	{
+		headBlock = headBlock->next;
+		headIndex = 0;
+	}
+
+	return headBlock->data() + headIndex;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+bool ConcurrentSpscDeque<T, BlockBytes, Allocator>::empty() const
+{
+	return size() == 0;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+std::size_t ConcurrentSpscDeque<T, BlockBytes, Allocator>::size() const
+{
+	std::size_t poppedCount = popped.load(std::memory_order_acquire);  //popped is read first,so the difference can't be negative
+	return pushed.load(std::memory_order_acquire) - poppedCount;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+Allocator ConcurrentSpscDeque<T, BlockBytes, Allocator>::get_allocator() const
+{
+	return allocator;
+}
@@ -1,755 +1,2760 @@
 #pragma once
-#include<list>
+#include"DequeSerializer.h"
+#include"DequeStats.h"
 #include<array>
+#include<algorithm>
+#include<atomic>
+#include<cstddef>
+#include<cstdint>
+#include<cstring>
 #include<iostream>
+#include<iterator>
+#include<memory>
+#include<new>
+#include<span>
+#include<stdexcept>
+#include<type_traits>
+#include<utility>
+#include<vector>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include<intrin.h>
+#endif
+
+//the alignment of a block.At 64 the elements of a block start on a cache line,so a block of 512 bytes spans 8 cache lines instead of 9.alignof(T) is used if it is larger
+#ifndef DEQUE_BLOCK_ALIGNMENT
+#define DEQUE_BLOCK_ALIGNMENT 64
+#endif
+
+//how many blocks ahead of the block being read a forward traversal prefetches,0 turns prefetching off.The blocks of a deque are separate allocations,so the hardware prefetcher can't follow a scan from one block to the next
+#ifndef DEQUE_PREFETCH_DISTANCE
+#define DEQUE_PREFETCH_DISTANCE 2
+#endif
+
+//asks the processor to start loading the cache line at address.It is only a hint,an address that isn't mapped doesn't fault
+inline void dequePrefetch(const void* address)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	__builtin_prefetch(address, 0, 3);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	_mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+	(void)address;
+#endif
+}
 
-template<typename T>
-class Deque
+constexpr std::size_t dequeLog2(std::size_t value)
 {
-	static const int mBlockSize = 8;
-	static const int mLastValidIndex = 7;
-	static const int mInitialIndex = 0;
+	std::size_t result = 0;
+	while (value > 1)
+	{
+		value >>= 1;
+		result++;
+	}
+	return result;
+}
 
-	struct Block
+template<typename T, std::size_t BlockBytes = 512, typename Allocator = std::allocator<T>, typename Stats = NoDequeStats>
+class Deque
+{
+	//the number of elements in a block is computed from the size of T the same way libstdc++ does it,so a block takes about BlockBytes bytes no matter the element type
+	static constexpr std::size_t mBlockSize = sizeof(T) < BlockBytes ? BlockBytes / sizeof(T) : 1;
+	static constexpr std::size_t mLastValidIndex = mBlockSize - 1;
+	static constexpr std::size_t mInitialIndex = 0;
+	static constexpr std::size_t mEmptyIndex = mBlockSize;  //both indices of an empty deque,it is past the end of a block so the fast paths of push_* and pop_* fail their bounds check without testing for an empty deque
+	static constexpr std::size_t mInitialMapSize = 8;
+	static constexpr std::size_t mMaxSpareBlocks = 2;
+	static constexpr bool mBlockSizeIsPowerOfTwo = (mBlockSize & (mBlockSize - 1)) == 0;
+	static constexpr std::size_t mBlockShift = mBlockSizeIsPowerOfTwo ? dequeLog2(mBlockSize) : 0;
+	static constexpr std::size_t mBlockAlignment = alignof(T) > DEQUE_BLOCK_ALIGNMENT ? alignof(T) : DEQUE_BLOCK_ALIGNMENT;
+	static constexpr std::size_t mCacheLineBytes = 64;
+	static constexpr std::size_t mPrefetchDistance = DEQUE_PREFETCH_DISTANCE;
+	static constexpr std::size_t mPrefetchBytes = sizeof(T) * mBlockSize < 8 * mCacheLineBytes ? sizeof(T) * mBlockSize : 8 * mCacheLineBytes;  //the start of a large block is enough for the hardware prefetcher to pick up the rest
+	static constexpr std::size_t mMapSlack = mPrefetchDistance > 0 ? mPrefetchDistance + 1 : 0;  //slots after the end of the directory,so a traversal that reached the last slot can read the slot it prefetches
+
+	//elements can be copied into a block with memcpy when T is trivially copyable and the source range is contiguous memory holding T
+	template<typename Iterator>
+	static constexpr bool mCopiesBytes = std::is_trivially_copyable_v<T> && std::is_same_v<std::remove_cv_t<typename std::iterator_traits<Iterator>::value_type>, T> &&
+#if defined(__cpp_lib_concepts)
+		std::contiguous_iterator<Iterator>;
+#else
+		std::is_pointer_v<Iterator>;
+#endif
+
+	static constexpr std::size_t blockNumber(std::size_t position);
+
+	static constexpr std::size_t offsetInBlock(std::size_t position);
+
+	//a block is raw storage,the elements are constructed in it when they are pushed and destroyed when they are popped,so T doesn't need a default constructor.A copy of a deque shares the blocks instead of copying them,references counts the deques whose directory points at the block
+	//the elements come first,so they start at the alignment of the block and a scan over them doesn't touch the reference count
+	struct alignas(mBlockAlignment) Block
 	{
-		std::array<T, mBlockSize> data;
-		Block* previous;
-		Block* next;
+		alignas(T) unsigned char storage[sizeof(T) * mBlockSize];
+		std::atomic<std::size_t> references;
 
-		Block() : previous(nullptr), next(nullptr) {}
+		T* data() { return std::launder(reinterpret_cast<T*>(storage)); }
 	};
 
-	std::list<Block*> blockAddresses;
-	Block* firstBlock;
-	Block* lastBlock;
-	int firstBlockIndex, lastBlockIndex;
+	using AllocatorTraits = std::allocator_traits<Allocator>;
+	using BlockAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Block>;
+	using MapAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Block*>;
+	using BlockAllocatorTraits = std::allocator_traits<BlockAllocator>;
+	using MapAllocatorTraits = std::allocator_traits<MapAllocator>;
+
+	Allocator allocator;
+
+	//blocks that were emptied by pop_* or clear() are kept here and reused by the next push that needs a block,so a deque that stays around the same size does not allocate
+	Block* spareBlocks[mMaxSpareBlocks];
+	std::size_t spareBlockCount;
+
+	//the blocks are kept in a contiguous directory of block pointers that can grow at both ends.The used part of the directory is [firstNode, lastNode] and the blocks in it are ordered from the front of the deque to the back
+	Block** blockMap;
+	std::size_t mapCapacity;
+	Block** firstNode;
+	Block** lastNode;
+	std::size_t firstBlockIndex, lastBlockIndex;  //the index of the first element in the first block and the index of the last element in the last block,mEmptyIndex while the deque is empty
+
+	//every slot in [reservedBegin, reservedEnd) holds a block.The slots around the used part hold idle blocks that pushes at that end fill before they allocate,an empty deque keeps its idle blocks in the same range
+	Block** reservedBegin;
+	Block** reservedEnd;
+	std::size_t frontReserve, backReserve;  //the room in elements that reserve_front and reserve_back asked for,idle blocks are only released while both ends keep that much room
+
+	//set when the deque was copied or copied from,so some of its blocks may be shared.While it is false no write has to check the reference count of a block.It is atomic because copying only reads the source deque and two threads may copy the same deque
+	mutable std::atomic<bool> sharesBlocks;
+
+	[[no_unique_address]] Stats statistics;  //NoDequeStats is empty and its calls do nothing,so a deque that doesn't count pays nothing for it
+
+	Block* allocateBlock();
+
+	void deallocateBlock(Block* block);
+
+	void releaseBlock(Block* block, std::size_t first, std::size_t last);
+
+	void unshareBlock(Block** node);
+
+	void unshareRange(std::size_t first, std::size_t last);
+
+	void unshareBlocks();
+
+	void shareBlocks(const Deque& other);
+
+	void releaseSpareBlocks();
+
+	Block** allocateMap(std::size_t capacity);
+
+	void releaseMap();
+
+	static void prefetchBlock(const Block* block);
+
+	void reallocateMap(std::size_t blocksToAdd, bool addAtFront);
+
+	void reserveMapAtBack(std::size_t blocksToAdd);
+
+	void reserveMapAtFront(std::size_t blocksToAdd);
+
+	T& elementAt(std::size_t index);
+
+	const T& elementAt(std::size_t index) const;
+
+	static constexpr std::size_t blocksFor(std::size_t elementCount);
+
+	Block** emptySplit() const;
+
+	bool dropReference(Block* block);
+
+	void emptyBlocks();
+
+	void trimIdleBlocks();
+
+	//the cold parts of push_* and pop_*,which move to another block,empty the deque or start it
+	template<typename... Args>
+	T& emplaceBackInNewBlock(Args&&... args);
+
+	template<typename... Args>
+	T& emplaceFrontInNewBlock(Args&&... args);
+
+	void popBackAcrossBlocks();
+
+	void popFrontAcrossBlocks();
+
+	void releaseIdleBlocks();
+
+	std::size_t surplusFrontBlocks() const;
+
+	std::size_t surplusBackBlocks() const;
+
+	Block* takeIdleFrontBlock();
+
+	Block* takeIdleBackBlock();
+
+	void stealContents(Deque& other);
+
+	template<typename Function>
+	void forEachSegment(std::size_t first, std::size_t last, Function function);
+
+	void moveLeft(std::size_t first, std::size_t last, std::size_t destination);
+
+	void moveRight(std::size_t first, std::size_t last, std::size_t destinationEnd);
+
+	void openGap(std::size_t index, std::size_t count, const T& placeholder);
+
+	void allocateBlocks(Block** first, Block** last);
+
+	void deallocateBlocks(Block** first, Block** last);
+
+	template<typename ForwardIterator>
+	void constructElements(Block** node, std::size_t blockIndex, std::size_t count, ForwardIterator first);
+
+	void readElements(std::istream& stream, Block** node, std::size_t count);
+
+	void relocateElements(Block* source, Block* target, std::size_t first, std::size_t last);
+
+	Block** openNodesAtBack(std::size_t count);
+
+	Block** openNodesAtFront(std::size_t count);
+
+	void forgetUsedBlocks();
+
+	void swapDirectories(Deque& other);
 
 public:
+	using allocator_type = Allocator;
+
 	Deque();
 
+	explicit Deque(const Allocator& allocator);
+
 	Deque(const Deque& other);
 
-	class Iterator
+	Deque(Deque&& other) noexcept;
+
+	~Deque();
+
+	//a position in the deque is the directory slot of its block and the index inside that block,so moving an iterator by any distance is a constant time computation
+	template<bool IsConst>
+	class BasicIterator
+	{
+		friend class Deque;
+		friend class BasicIterator<!IsConst>;
+
+		Block** node;
+		std::size_t blockIndex;
+
+		BasicIterator(Block** node, std::size_t blockIndex) : node(node), blockIndex(blockIndex) {}
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using iterator_concept = std::random_access_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<IsConst, const T*, T*>;
+		using reference = std::conditional_t<IsConst, const T&, T&>;
+
+		BasicIterator() : node(nullptr), blockIndex(mInitialIndex) {}
+
+		template<bool OtherIsConst, typename = std::enable_if_t<IsConst && !OtherIsConst>>
+		BasicIterator(const BasicIterator<OtherIsConst>& other) : node(other.node), blockIndex(other.blockIndex) {}  //an Iterator converts to a ConstIterator
+
+		reference operator*() const;
+		pointer operator->() const;
+		reference operator[](difference_type steps) const;
+		BasicIterator& operator++();
+		BasicIterator& operator--();
+		BasicIterator operator++(int);
+		BasicIterator operator--(int);
+		BasicIterator& operator+=(difference_type steps);
+		BasicIterator& operator-=(difference_type steps);
+		BasicIterator operator+(difference_type steps) const;
+		BasicIterator operator-(difference_type steps) const;
+
+		template<bool OtherIsConst>
+		difference_type operator-(const BasicIterator<OtherIsConst>& other) const;
+
+		template<bool OtherIsConst>
+		bool operator==(const BasicIterator<OtherIsConst>& other) const;
+
+		template<bool OtherIsConst>
+		bool operator!=(const BasicIterator<OtherIsConst>& other) const;
+
+		template<bool OtherIsConst>
+		bool operator<(const BasicIterator<OtherIsConst>& other) const;
+
+		template<bool OtherIsConst>
+		bool operator>(const BasicIterator<OtherIsConst>& other) const;
+
+		template<bool OtherIsConst>
+		bool operator<=(const BasicIterator<OtherIsConst>& other) const;
+
+		template<bool OtherIsConst>
+		bool operator>=(const BasicIterator<OtherIsConst>& other) const;
+
+		friend BasicIterator operator+(difference_type steps, const BasicIterator& it) { return it + steps; }
+	};
+
+	using Iterator = BasicIterator<false>;
+	using ConstIterator = BasicIterator<true>;
+
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = T&;
+	using const_reference = const T&;
+	using iterator = Iterator;
+	using const_iterator = ConstIterator;
+	using reverse_iterator = std::reverse_iterator<Iterator>;
+	using const_reverse_iterator = std::reverse_iterator<ConstIterator>;
+
+	//a segment is the contiguous part of the deque that is stored in one block,so a loop over a segment runs over plain memory and can be vectorized.The segments are visited from the front of the deque to the back
+	template<bool IsConst>
+	class BasicSegmentIterator
 	{
 		friend class Deque;
 
-		Deque& dequeReference;
+		Block** node;
+		Block** firstNode;
+		Block** lastNode;
+		std::size_t firstBlockIndex, lastBlockIndex;
+
+		BasicSegmentIterator(Block** node, Block** firstNode, Block** lastNode, std::size_t firstBlockIndex, std::size_t lastBlockIndex) : node(node), firstNode(firstNode), lastNode(lastNode), firstBlockIndex(firstBlockIndex), lastBlockIndex(lastBlockIndex) {}
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = std::span<std::conditional_t<IsConst, const T, T>>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = value_type;
+
+		BasicSegmentIterator() : node(nullptr), firstNode(nullptr), lastNode(nullptr), firstBlockIndex(mInitialIndex), lastBlockIndex(mInitialIndex) {}
+
+		value_type operator*() const;
+		BasicSegmentIterator& operator++();
+		BasicSegmentIterator operator++(int);
+		bool operator==(const BasicSegmentIterator& other) const;
+		bool operator!=(const BasicSegmentIterator& other) const;
+	};
 
-		Block* block;
-		int blockIndex;
+	template<bool IsConst>
+	class BasicSegmentView
+	{
+		BasicSegmentIterator<IsConst> first, last;
 
 	public:
-		Iterator() : block(nullptr), blockIndex(mInitialIndex), dequeReference(nullptr) {}
-		Iterator(Deque& dequeRef) : dequeReference(dequeRef), block(nullptr), blockIndex(mInitialIndex) {}
-
-		T* operator->();
-		T& operator*();
-		Iterator& operator=(const Iterator& other);
-		bool operator==(const Iterator& other);
-		bool operator!=(const Iterator& other);
-		Iterator& operator++();
-		Iterator& operator--();
-		Iterator operator++(int);
-		Iterator operator--(int);
-		Iterator operator+(int stepsForward);
-		Iterator operator-(int stepsBackwards);
-		Iterator& operator+=(int steps);
-		Iterator& operator-=(int steps);
+		BasicSegmentView(BasicSegmentIterator<IsConst> first, BasicSegmentIterator<IsConst> last) : first(first), last(last) {}
+
+		BasicSegmentIterator<IsConst> begin() const { return first; }
+		BasicSegmentIterator<IsConst> end() const { return last; }
 	};
 
+	using SegmentView = BasicSegmentView<false>;
+	using ConstSegmentView = BasicSegmentView<true>;
+
 	void push_back(const T& value);
 
+	void push_back(T&& value);
+
 	void push_front(const T& value);
 
+	void push_front(T&& value);
+
+	template<typename... Args>
+	T& emplace_back(Args&&... args);
+
+	template<typename... Args>
+	T& emplace_front(Args&&... args);
+
 	void pop_back();
 
 	void pop_front();
 
+	//remove the first / last count elements,or all of them if the deque has fewer.The blocks that are emptied are released in one step instead of one pop at a time
+	void pop_front_n(std::size_t count);
+
+	void pop_back_n(std::size_t count);
+
+	//moves the first count elements,or all of them if the deque has fewer,to output in order and removes them.Elements of trivially copyable T are copied with memcpy when output is contiguous memory,and elements of blocks that are shared with a copy are copied instead of moved
+	template<typename OutputIterator>
+	OutputIterator drain_front(OutputIterator output, std::size_t count);
+
+	//calls function with a std::span<T> for every block's worth of the first count elements in order,then removes them and returns how many there were.The function may move from the elements.If it throws,no element is removed
+	template<typename Function>
+	std::size_t consume_front(std::size_t count, Function function);
+
 	T& front();
 
+	const T& front() const;
+
 	T& back();
 
-	T& operator[](int index);
+	const T& back() const;
+
+	T& operator[](std::size_t index);
+
+	const T& operator[](std::size_t index) const;
 
 	Deque& operator=(const Deque& other);
 
-	bool empty();
+	Deque& operator=(Deque&& other) noexcept(std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value || std::allocator_traits<Allocator>::is_always_equal::value);
+
+	bool empty() const;
 
 	void clear();
 
-	int size();
+	std::size_t size() const;
+
+	void insert(const T& value, std::size_t index);
+
+	void insert(std::size_t index, std::size_t count, const T& value);
+
+	template<typename InputIterator, typename = std::enable_if_t<!std::is_integral_v<InputIterator>>>
+	void insert(std::size_t index, InputIterator first, InputIterator last);
+
+	void remove(std::size_t index);
 
-	void insert(const T& value, int index);
+	void erase(std::size_t first, std::size_t last);
 
-	void remove(int index);
+	template<typename InputIterator, typename = std::enable_if_t<!std::is_integral_v<InputIterator>>>
+	void append(InputIterator first, InputIterator last);
+
+	template<typename InputIterator, typename = std::enable_if_t<!std::is_integral_v<InputIterator>>>
+	void prepend(InputIterator first, InputIterator last);
+
+	template<typename InputIterator, typename = std::enable_if_t<!std::is_integral_v<InputIterator>>>
+	void assign(InputIterator first, InputIterator last);
+
+	//moves the elements of other to the back / front of this deque and leaves other empty.When the elements of other sit in their blocks at the positions they get in this deque,the blocks are moved over and only the boundary block of the smaller side is moved into the other boundary block,so the cost depends on the number of blocks.Otherwise the smaller deque is moved element by element
+	void splice_back(Deque&& other);
+
+	void splice_front(Deque&& other);
+
+	//moves the elements [index, size()) to a new deque and returns it.The blocks after the one index falls in are moved over and only the smaller part of that block is moved to a new block
+	Deque split_at(std::size_t index);
 
 	Iterator begin();
 
 	Iterator end();
+
+	ConstIterator begin() const;
+
+	ConstIterator end() const;
+
+	ConstIterator cbegin() const;
+
+	ConstIterator cend() const;
+
+	reverse_iterator rbegin();
+
+	reverse_iterator rend();
+
+	const_reverse_iterator rbegin() const;
+
+	const_reverse_iterator rend() const;
+
+	const_reverse_iterator crbegin() const;
+
+	const_reverse_iterator crend() const;
+
+	SegmentView segments();
+
+	ConstSegmentView segments() const;
+
+	void reserve_front(std::size_t count);
+
+	void reserve_back(std::size_t count);
+
+	std::size_t capacity_front() const;
+
+	std::size_t capacity_back() const;
+
+	void shrink_to_fit();
+
+	//writes a DequeStreamHeader followed by the elements from the front to the back.Trivially copyable elements are written as one raw range per block,other types through DequeSerializer<T>
+	void save(std::ostream& stream) const;
+
+	//replaces the contents of the deque with the elements written by save,reading them straight into the blocks.If the stream is truncated or was saved for another element type,the deque is left empty and std::runtime_error is thrown
+	void load(std::istream& stream);
+
+	//the event counters of the Stats policy together with the current memory footprint
+	DequeStats stats() const;
+
+	void reset_stats();
+
+	Allocator get_allocator() const;
 };
 
-template<typename T>
-Deque<T>& Deque<T>::operator=(const Deque& other)
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+Deque<T, BlockBytes, Allocator, Stats>& Deque<T, BlockBytes, Allocator, Stats>::operator=(const Deque& other)
 {
 	if (this == &other)  //prevent self-assignment
 		return *this;
 
 	clear();
 
-	for (const Block* block : other.blockAddresses)
+	if constexpr (std::allocator_traits<Allocator>::propagate_on_container_copy_assignment::value)
+	{
+		if (allocator != other.allocator)  //the memory owned by this deque has to be released with the old allocator before it is replaced
+		{
+			releaseIdleBlocks();
+			releaseSpareBlocks();
+			releaseMap();
+		}
+		allocator = other.allocator;
+	}
+
+	if (allocator == other.allocator)  //a block can only be shared if this allocator is able to free it
+		shareBlocks(other);
+	else
+		append(other.begin(), other.end());
+
+	return *this;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+Deque<T, BlockBytes, Allocator, Stats>& Deque<T, BlockBytes, Allocator, Stats>::operator=(Deque&& other) noexcept(std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value || std::allocator_traits<Allocator>::is_always_equal::value)
+{
+	if (this == &other)
+		return *this;
+
+	clear();
+
+	if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value || AllocatorTraits::is_always_equal::value)
+	{
+		stealContents(other);
+	}
+	else
+	{
+		if (allocator == other.allocator)  //the blocks can only be taken over if this allocator is able to free them
+		{
+			stealContents(other);
+		}
+		else
+		{
+			other.unshareBlocks();  //the elements are moved out,so they must not be shared with a third deque
+			std::size_t otherSize = other.size();
+			for (std::size_t i = 0; i < otherSize; i++)
+				emplace_back(std::move(other.elementAt(i)));
+			other.clear();
+		}
+	}
+
+	return *this;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::stealContents(Deque& other)
+{
+	releaseIdleBlocks();
+	releaseSpareBlocks();
+	releaseMap();
+
+	if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value)
+		allocator = std::move(other.allocator);
+
+	std::copy(other.spareBlocks, other.spareBlocks + other.spareBlockCount, spareBlocks);
+	spareBlockCount = other.spareBlockCount;
+	blockMap = other.blockMap;
+	mapCapacity = other.mapCapacity;
+	firstNode = other.firstNode;
+	lastNode = other.lastNode;
+	firstBlockIndex = other.firstBlockIndex;
+	lastBlockIndex = other.lastBlockIndex;
+	reservedBegin = other.reservedBegin;
+	reservedEnd = other.reservedEnd;
+	frontReserve = other.frontReserve;
+	backReserve = other.backReserve;
+	sharesBlocks.store(other.sharesBlocks.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+	other.spareBlockCount = 0;
+	other.blockMap = nullptr;
+	other.mapCapacity = 0;
+	other.firstNode = nullptr;
+	other.lastNode = nullptr;
+	other.firstBlockIndex = mEmptyIndex;
+	other.lastBlockIndex = mEmptyIndex;
+	other.reservedBegin = nullptr;
+	other.reservedEnd = nullptr;
+	other.frontReserve = 0;
+	other.backReserve = 0;
+	other.sharesBlocks.store(false, std::memory_order_relaxed);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::shareBlocks(const Deque& other)
+{
+	if (other.firstNode == nullptr)
+		return;
+
+	//the copy gets its own directory that points at the blocks of other,so it costs one pointer copy and one reference count increment per block and no element is copied.The idle blocks of this deque behind the split are moved back to make room
+	std::size_t blockCount = other.lastNode - other.firstNode + 1;
+	reserveMapAtBack(blockCount);
+	Block** split = emptySplit();
+	std::copy_backward(split, reservedEnd, reservedEnd + blockCount);
+	reservedEnd += blockCount;
+	firstNode = split;
+	lastNode = split + blockCount - 1;
+	for (std::size_t i = 0; i < blockCount; i++)
+	{
+		other.firstNode[i]->references.fetch_add(1, std::memory_order_relaxed);
+		firstNode[i] = other.firstNode[i];
+	}
+	firstBlockIndex = other.firstBlockIndex;
+	lastBlockIndex = other.lastBlockIndex;
+
+	sharesBlocks.store(true, std::memory_order_relaxed);
+	other.sharesBlocks.store(true, std::memory_order_relaxed);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+Deque<T, BlockBytes, Allocator, Stats>::Deque() : Deque(Allocator()) {}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+Deque<T, BlockBytes, Allocator, Stats>::Deque(const Allocator& allocator) : allocator(allocator), spareBlockCount(0), blockMap(nullptr), mapCapacity(0), firstNode(nullptr), lastNode(nullptr), firstBlockIndex(mEmptyIndex), lastBlockIndex(mEmptyIndex), reservedBegin(nullptr), reservedEnd(nullptr), frontReserve(0), backReserve(0), sharesBlocks(false), statistics() {}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+Deque<T, BlockBytes, Allocator, Stats>::Deque(const Deque& other) : Deque(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.allocator))
+{
+	*this = other;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+Deque<T, BlockBytes, Allocator, Stats>::Deque(Deque&& other) noexcept : Deque(std::move(other.allocator))
+{
+	stealContents(other);  //moving a deque only hands over the block directory,no element is touched
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+Deque<T, BlockBytes, Allocator, Stats>::~Deque()
+{
+	if (blockMap == nullptr && spareBlockCount == 0)  //a deque that never got a block owns no memory,so a short-lived empty deque is destroyed without a call
+		return;
+
+	clear();
+	releaseIdleBlocks();
+	releaseSpareBlocks();
+	releaseMap();
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+typename Deque<T, BlockBytes, Allocator, Stats>::Block* Deque<T, BlockBytes, Allocator, Stats>::allocateBlock()
+{
+	Block* block;
+	if (spareBlockCount > 0)
+	{
+		block = spareBlocks[--spareBlockCount];
+		statistics.count(&DequeCounters::blockReuses);
+	}
+	else
+	{
+		BlockAllocator blockAllocator(allocator);
+		block = BlockAllocatorTraits::allocate(blockAllocator, 1);
+		statistics.count(&DequeCounters::blockAllocations);
+	}
+
+	::new (static_cast<void*>(&block->references)) std::atomic<std::size_t>(1);
+	return block;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::deallocateBlock(Block* block)
+{
+	if (spareBlockCount < mMaxSpareBlocks)  //the number of kept blocks is bounded,so a deque that shrank a lot still returns its memory
+	{
+		spareBlocks[spareBlockCount++] = block;
+		return;
+	}
+
+	BlockAllocator blockAllocator(allocator);
+	BlockAllocatorTraits::deallocate(blockAllocator, block, 1);
+	statistics.count(&DequeCounters::blockDeallocations);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::releaseBlock(Block* block, std::size_t first, std::size_t last)
+{
+	//a block that only this deque uses is freed at once.A shared block loses one reference,and the deque that drops the last one destroys the elements,every deque that shares a block has the same elements in it because a deque clones a shared block before it changes it
+	if (!dropReference(block))
+		return;
+
+	if constexpr (!std::is_trivially_destructible_v<T>)
+	{
+		for (T* element = block->data() + first; element != block->data() + last; ++element)
+			AllocatorTraits::destroy(allocator, element);
+	}
+	deallocateBlock(block);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+bool Deque<T, BlockBytes, Allocator, Stats>::dropReference(Block* block)
+{
+	if (block->references.load(std::memory_order_acquire) == 1)
+		return true;
+
+	if (block->references.fetch_sub(1, std::memory_order_acq_rel) == 1)  //the other deques let go of the block in the meantime,so it belongs to this deque again
+	{
+		block->references.store(1, std::memory_order_relaxed);
+		return true;
+	}
+	return false;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::unshareBlock(Block** node)
+{
+	Block* block = *node;
+	if (block->references.load(std::memory_order_acquire) == 1)  //the acquire makes sure the other deques were done with the block before this deque writes to it
+		return;
+
+	std::size_t first = node == firstNode ? firstBlockIndex : mInitialIndex;
+	std::size_t last = node == lastNode ? lastBlockIndex + 1 : mBlockSize;
+	Block* copy = allocateBlock();
+	if constexpr (std::is_trivially_copyable_v<T>)
+	{
+		std::memcpy(static_cast<void*>(copy->data() + first), block->data() + first, (last - first) * sizeof(T));
+	}
+	else
+	{
+		std::size_t index = first;
+		try
+		{
+			for (; index != last; index++)
+				AllocatorTraits::construct(allocator, copy->data() + index, std::as_const(block->data()[index]));
+		}
+		catch (...)  //the deque still points at the shared block,so it is unchanged
+		{
+			for (std::size_t i = first; i != index; i++)
+				AllocatorTraits::destroy(allocator, copy->data() + i);
+			deallocateBlock(copy);
+			throw;
+		}
+	}
+
+	*node = copy;
+	releaseBlock(block, first, last);
+	statistics.count(&DequeCounters::blockClones);
+	statistics.count(&DequeCounters::clonedElements, last - first);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::unshareRange(std::size_t first, std::size_t last)
+{
+	if (!sharesBlocks.load(std::memory_order_relaxed) || first == last)
+		return;
+
+	Block** lastBlock = firstNode + blockNumber(firstBlockIndex + last - 1);
+	for (Block** node = firstNode + blockNumber(firstBlockIndex + first); node <= lastBlock; ++node)
+		unshareBlock(node);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::unshareBlocks()
+{
+	if (!sharesBlocks.load(std::memory_order_relaxed))
+		return;
+
+	if (firstNode != nullptr)
+	{
+		for (Block** node = firstNode; node <= lastNode; ++node)
+			unshareBlock(node);
+	}
+	sharesBlocks.store(false, std::memory_order_relaxed);  //every block is owned by this deque alone now,so writes don't have to check again until the next copy
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::releaseSpareBlocks()
+{
+	BlockAllocator blockAllocator(allocator);
+	for (std::size_t i = 0; i < spareBlockCount; i++)
+		BlockAllocatorTraits::deallocate(blockAllocator, spareBlocks[i], 1);
+	statistics.count(&DequeCounters::blockDeallocations, spareBlockCount);
+	spareBlockCount = 0;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+typename Deque<T, BlockBytes, Allocator, Stats>::Block** Deque<T, BlockBytes, Allocator, Stats>::allocateMap(std::size_t capacity)
+{
+	MapAllocator mapAllocator(allocator);
+	Block** map = MapAllocatorTraits::allocate(mapAllocator, capacity + mMapSlack);
+	if constexpr (mPrefetchDistance > 0)  //a traversal prefetches the block of any slot it reads,so no slot may be left uninitialized
+		std::fill(map, map + capacity + mMapSlack, nullptr);
+	return map;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::releaseMap()
+{
+	if (blockMap != nullptr)
+	{
+		MapAllocator mapAllocator(allocator);
+		MapAllocatorTraits::deallocate(mapAllocator, blockMap, mapCapacity + mMapSlack);
+	}
+
+	blockMap = nullptr;
+	mapCapacity = 0;
+	reservedBegin = nullptr;
+	reservedEnd = nullptr;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::prefetchBlock(const Block* block)
+{
+	//the slots outside the used part of the directory can be null or hold a block that was freed,so the address is only computed as a number and never dereferenced
+	std::uintptr_t address = reinterpret_cast<std::uintptr_t>(block);
+	if (address == 0)
+		return;
+	for (std::size_t offset = 0; offset < mPrefetchBytes; offset += mCacheLineBytes)
+		dequePrefetch(reinterpret_cast<const void*>(address + offset));
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::save(std::ostream& stream) const
+{
+	static_assert(DequeSerializable<T> || std::is_trivially_copyable_v<T>, "Deque::save needs a trivially copyable T or a DequeSerializer<T> specialization");
+
+	DequeStreamHeader header{ DequeStreamHeader::mMagic, DequeStreamHeader::mVersion, DequeSerializable<T> ? DequeStreamHeader::mSerializerFormat : DequeStreamHeader::mRawFormat, sizeof(T), size() };
+	stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	for (std::span<const T> segment : segments())
+	{
+		if constexpr (DequeSerializable<T>)
+		{
+			for (const T& element : segment)
+				DequeSerializer<T>::write(stream, element);
+		}
+		else
+		{
+			stream.write(reinterpret_cast<const char*>(segment.data()), static_cast<std::streamsize>(segment.size_bytes()));
+		}
+	}
+
+	if (!stream)
+		throw std::runtime_error("Deque could not be written to the stream");
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::load(std::istream& stream)
+{
+	static_assert(DequeSerializable<T> || std::is_trivially_copyable_v<T>, "Deque::load needs a trivially copyable T or a DequeSerializer<T> specialization");
+
+	//like assign,the blocks the deque already has become idle and are filled first.The elements are read into the blocks from the split on and the deque is only updated at the end
+	emptyBlocks();
+
+	DequeStreamHeader header;
+	const char* error = nullptr;
+	if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		error = "Deque stream is truncated";
+	else if (header.magic != DequeStreamHeader::mMagic || header.version != DequeStreamHeader::mVersion)
+		error = "Deque stream has an unknown format";
+	else if (header.format != (DequeSerializable<T> ? DequeStreamHeader::mSerializerFormat : DequeStreamHeader::mRawFormat) || header.elementSize != sizeof(T))
+		error = "Deque stream was saved for another element type";
+	if (error != nullptr)
+	{
+		trimIdleBlocks();
+		throw std::runtime_error(error);
+	}
+
+	//the blocks are allocated as the elements arrive,so a count that is larger than the stream fails with a truncated stream after at most one block instead of allocating memory for every element it claims
+	std::size_t count = static_cast<std::size_t>(header.count);
+	std::size_t splitOffset = emptySplit() - reservedBegin;  //an offset,because the directory can move while it grows
+	std::size_t loaded = 0;
+	try
+	{
+		while (loaded < count)
+		{
+			Block** node = reservedBegin + splitOffset + blockNumber(loaded);
+			if (node == reservedEnd)
+			{
+				reserveMapAtBack(1);
+				node = reservedBegin + splitOffset + blockNumber(loaded);
+				allocateBlocks(node, node + 1);
+				reservedEnd++;
+			}
+
+			std::size_t length = std::min(mBlockSize, count - loaded);
+			readElements(stream, node, length);
+			loaded += length;
+		}
+	}
+	catch (...)
+	{
+		Block** split = reservedBegin + splitOffset;
+		for (std::size_t i = 0; i < loaded; i++)
+			AllocatorTraits::destroy(allocator, split[blockNumber(i)]->data() + offsetInBlock(i));
+		trimIdleBlocks();
+		throw;
+	}
+
+	if (count > 0)
+	{
+		firstNode = reservedBegin + splitOffset;
+		lastNode = firstNode + blocksFor(count) - 1;
+		firstBlockIndex = mInitialIndex;
+		lastBlockIndex = offsetInBlock(count - 1);
+	}
+	trimIdleBlocks();
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+DequeStats Deque<T, BlockBytes, Allocator, Stats>::stats() const
+{
+	DequeStats result;
+	static_cast<DequeCounters&>(result) = statistics.counters();
+
+	result.size = size();
+	result.usedBlocks = firstNode != nullptr ? lastNode - firstNode + 1 : 0;
+	result.idleBlocks = reservedEnd - reservedBegin - result.usedBlocks;
+	result.spareBlocks = spareBlockCount;
+	result.mapCapacity = mapCapacity;
+	result.blockBytes = sizeof(Block);
+	result.footprintBytes = sizeof(Deque) + (result.usedBlocks + result.idleBlocks + result.spareBlocks) * sizeof(Block) + (blockMap != nullptr ? mapCapacity + mMapSlack : 0) * sizeof(Block*);
+	result.elementBytes = result.size * sizeof(T);
+	return result;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::reset_stats()
+{
+	statistics.reset();
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+Allocator Deque<T, BlockBytes, Allocator, Stats>::get_allocator() const
+{
+	return allocator;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::reserve_front(std::size_t count)
+{
+	frontReserve = std::max(frontReserve, count);  //the reserve is kept,so the blocks emptied by pop_front and clear() stay around for the next burst
+
+	//an empty deque needs the blocks for both reserves,the split between them follows from frontReserve
+	std::size_t blocksToAdd;
+	if (firstNode == nullptr)
+		blocksToAdd = blocksFor(frontReserve) + blocksFor(backReserve) - std::min(blocksFor(frontReserve) + blocksFor(backReserve), static_cast<std::size_t>(reservedEnd - reservedBegin));
+	else
+		blocksToAdd = blocksFor(frontReserve - std::min(frontReserve, capacity_front()));
+
+	//the directory gets room to re-center the reserved blocks,so a deque that moves through them never has to grow it
+	std::size_t reservedBlocks = reservedEnd - reservedBegin + blocksToAdd;
+	if (mapCapacity <= 2 * (reservedBlocks + 1))
+		reallocateMap(2 * (reservedBlocks + 1), true);
+	else
+		reserveMapAtFront(blocksToAdd);
+	for (std::size_t i = 0; i < blocksToAdd; i++)
+	{
+		*(reservedBegin - 1) = allocateBlock();
+		--reservedBegin;
+	}
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::reserve_back(std::size_t count)
+{
+	backReserve = std::max(backReserve, count);
+
+	std::size_t blocksToAdd;
+	if (firstNode == nullptr)
+		blocksToAdd = blocksFor(frontReserve) + blocksFor(backReserve) - std::min(blocksFor(frontReserve) + blocksFor(backReserve), static_cast<std::size_t>(reservedEnd - reservedBegin));
+	else
+		blocksToAdd = blocksFor(backReserve - std::min(backReserve, capacity_back()));
+
+	//the directory gets room to re-center the reserved blocks,so a deque that moves through them never has to grow it
+	std::size_t reservedBlocks = reservedEnd - reservedBegin + blocksToAdd;
+	if (mapCapacity <= 2 * (reservedBlocks + 1))
+		reallocateMap(2 * (reservedBlocks + 1), false);
+	else
+		reserveMapAtBack(blocksToAdd);
+	for (std::size_t i = 0; i < blocksToAdd; i++)
+	{
+		*reservedEnd = allocateBlock();
+		++reservedEnd;
+	}
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+std::size_t Deque<T, BlockBytes, Allocator, Stats>::capacity_front() const
+{
+	if (firstNode == nullptr)
+		return (emptySplit() - reservedBegin) * mBlockSize;
+
+	return firstBlockIndex + (firstNode - reservedBegin + surplusBackBlocks()) * mBlockSize;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+std::size_t Deque<T, BlockBytes, Allocator, Stats>::capacity_back() const
+{
+	if (firstNode == nullptr)
+		return (reservedEnd - emptySplit()) * mBlockSize;
+
+	return mLastValidIndex - lastBlockIndex + (reservedEnd - lastNode - 1 + surplusFrontBlocks()) * mBlockSize;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::shrink_to_fit()
+{
+	frontReserve = 0;
+	backReserve = 0;
+	releaseIdleBlocks();
+	releaseSpareBlocks();
+
+	if (firstNode == nullptr)
+	{
+		releaseMap();
+		return;
+	}
+
+	//the directory is replaced by the smallest one that still has a free slot at each end
+	std::size_t blockCount = lastNode - firstNode + 1;
+	std::size_t newMapCapacity = std::max(mInitialMapSize, blockCount + 2);
+	if (newMapCapacity >= mapCapacity)
+		return;
+
+	Block** newMap = allocateMap(newMapCapacity);
+	Block** newFirstNode = newMap + (newMapCapacity - blockCount) / 2;
+	std::copy(firstNode, lastNode + 1, newFirstNode);
+
+	releaseMap();
+	blockMap = newMap;
+	mapCapacity = newMapCapacity;
+	statistics.count(&DequeCounters::mapReallocations);
+	firstNode = newFirstNode;
+	lastNode = newFirstNode + blockCount - 1;
+	reservedBegin = firstNode;
+	reservedEnd = lastNode + 1;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::reallocateMap(std::size_t blocksToAdd, bool addAtFront)
+{
+	//the whole reserved range is moved,the used part keeps its offset inside it
+	std::size_t oldBlockCount = reservedEnd - reservedBegin;
+	std::size_t newBlockCount = oldBlockCount + blocksToAdd;
+	std::size_t firstOffset = firstNode != nullptr ? firstNode - reservedBegin : 0;
+	std::size_t lastOffset = firstNode != nullptr ? lastNode - reservedBegin : 0;
+
+	Block** newReservedBegin;
+	if (mapCapacity > 2 * newBlockCount)  //if less than half of the directory is used,the blocks are only re-centered instead of allocating a bigger directory
+	{
+		newReservedBegin = blockMap + (mapCapacity - newBlockCount) / 2 + (addAtFront ? blocksToAdd : 0);
+		if (newReservedBegin < reservedBegin)
+			std::copy(reservedBegin, reservedEnd, newReservedBegin);
+		else
+			std::copy_backward(reservedBegin, reservedEnd, newReservedBegin + oldBlockCount);
+		statistics.count(&DequeCounters::mapRecenters);
+	}
+	else  //the directory grows geometrically so pushing at either end stays amortized O(1).It keeps at least one free slot at each end,so the first push in either direction does not have to move it
+	{
+		std::size_t newMapCapacity = std::max(mInitialMapSize, mapCapacity + std::max(mapCapacity, blocksToAdd) + 2);
+		Block** newMap = allocateMap(newMapCapacity);
+		newReservedBegin = newMap + (newMapCapacity - newBlockCount) / 2 + (addAtFront ? blocksToAdd : 0);  //a new deque starts in the middle so it can grow the same amount in both directions
+		std::copy(reservedBegin, reservedEnd, newReservedBegin);
+
+		releaseMap();
+		blockMap = newMap;
+		mapCapacity = newMapCapacity;
+		statistics.count(&DequeCounters::mapReallocations);
+	}
+
+	reservedBegin = newReservedBegin;
+	reservedEnd = newReservedBegin + oldBlockCount;
+	if (firstNode != nullptr)
+	{
+		firstNode = newReservedBegin + firstOffset;
+		lastNode = newReservedBegin + lastOffset;
+	}
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::reserveMapAtBack(std::size_t blocksToAdd)
+{
+	if (blocksToAdd > static_cast<std::size_t>(blockMap + mapCapacity - reservedEnd))
+		reallocateMap(blocksToAdd, false);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::reserveMapAtFront(std::size_t blocksToAdd)
+{
+	if (blocksToAdd > static_cast<std::size_t>(reservedBegin - blockMap))
+		reallocateMap(blocksToAdd, true);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+constexpr std::size_t Deque<T, BlockBytes, Allocator, Stats>::blocksFor(std::size_t elementCount)
+{
+	return elementCount == 0 ? 0 : blockNumber(elementCount - 1) + 1;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+typename Deque<T, BlockBytes, Allocator, Stats>::Block** Deque<T, BlockBytes, Allocator, Stats>::emptySplit() const
+{
+	//an empty deque puts its first push_back at the start of this slot and its first push_front at the end of the slot before it,so the room reserve_front asked for stays in front of the first element
+	return reservedBegin + std::min(blocksFor(frontReserve), static_cast<std::size_t>(reservedEnd - reservedBegin));
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::emptyBlocks()
+{
+	if (firstNode == nullptr)
+		return;
+
+	//the blocks this deque owns become idle blocks and are packed together with the idle blocks behind the deque,the shared blocks are left to the other deques
+	Block** kept = firstNode;
+	for (Block** node = firstNode; node <= lastNode; ++node)
+	{
+		Block* block = *node;
+		if (dropReference(block))
+		{
+			if constexpr (!std::is_trivially_destructible_v<T>)
+			{
+				std::size_t first = node == firstNode ? firstBlockIndex : mInitialIndex;
+				std::size_t last = node == lastNode ? lastBlockIndex + 1 : mBlockSize;
+				for (T* element = block->data() + first; element != block->data() + last; ++element)
+					AllocatorTraits::destroy(allocator, element);
+			}
+			*kept++ = block;
+		}
+	}
+	reservedEnd = std::copy(lastNode + 1, reservedEnd, kept);
+
+	firstNode = nullptr;
+	lastNode = nullptr;
+	firstBlockIndex = mEmptyIndex;
+	lastBlockIndex = mEmptyIndex;
+	sharesBlocks.store(false, std::memory_order_relaxed);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::trimIdleBlocks()
+{
+	if (firstNode == nullptr)
+	{
+		std::size_t blocksNeeded = blocksFor(frontReserve) + blocksFor(backReserve);
+		while (static_cast<std::size_t>(reservedEnd - reservedBegin) > blocksNeeded)
+			deallocateBlock(*--reservedEnd);
+		return;
+	}
+
+	//an end keeps the idle blocks it needs for its reserve and the ones the other end is missing,because a push at the other end takes idle blocks from this one before it allocates
+	std::size_t roomInFirstBlock = firstBlockIndex;
+	std::size_t roomInLastBlock = mLastValidIndex - lastBlockIndex;
+	std::size_t frontNeeded = frontReserve > roomInFirstBlock ? blocksFor(frontReserve - roomInFirstBlock) : 0;
+	std::size_t backNeeded = backReserve > roomInLastBlock ? blocksFor(backReserve - roomInLastBlock) : 0;
+	std::size_t frontIdle = firstNode - reservedBegin;
+	std::size_t backIdle = reservedEnd - lastNode - 1;
+	std::size_t frontKept = frontNeeded + (backNeeded > backIdle ? backNeeded - backIdle : 0);
+	std::size_t backKept = backNeeded + (frontNeeded > frontIdle ? frontNeeded - frontIdle : 0);
+
+	for (; frontIdle > frontKept; frontIdle--)
+		deallocateBlock(*reservedBegin++);
+	for (; backIdle > backKept; backIdle--)
+		deallocateBlock(*--reservedEnd);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::releaseIdleBlocks()
+{
+	Block** usedBegin = firstNode != nullptr ? firstNode : reservedEnd;
+	Block** usedEnd = firstNode != nullptr ? lastNode + 1 : reservedEnd;
+	deallocateBlocks(reservedBegin, usedBegin);
+	deallocateBlocks(usedEnd, reservedEnd);
+	reservedBegin = usedBegin;
+	reservedEnd = usedEnd;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+std::size_t Deque<T, BlockBytes, Allocator, Stats>::surplusFrontBlocks() const
+{
+	//the idle blocks in front of a non-empty deque that the front reserve doesn't need,a push at the back takes them before it allocates
+	std::size_t frontNeeded = frontReserve > firstBlockIndex ? blocksFor(frontReserve - firstBlockIndex) : 0;
+	std::size_t frontIdle = firstNode - reservedBegin;
+	return frontIdle > frontNeeded ? frontIdle - frontNeeded : 0;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+std::size_t Deque<T, BlockBytes, Allocator, Stats>::surplusBackBlocks() const
+{
+	std::size_t roomInLastBlock = mLastValidIndex - lastBlockIndex;
+	std::size_t backNeeded = backReserve > roomInLastBlock ? blocksFor(backReserve - roomInLastBlock) : 0;
+	std::size_t backIdle = reservedEnd - lastNode - 1;
+	return backIdle > backNeeded ? backIdle - backNeeded : 0;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+typename Deque<T, BlockBytes, Allocator, Stats>::Block* Deque<T, BlockBytes, Allocator, Stats>::takeIdleFrontBlock()
+{
+	if (surplusFrontBlocks() == 0)
+		return nullptr;
+
+	statistics.count(&DequeCounters::blockReuses);
+	return *reservedBegin++;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+typename Deque<T, BlockBytes, Allocator, Stats>::Block* Deque<T, BlockBytes, Allocator, Stats>::takeIdleBackBlock()
+{
+	if (surplusBackBlocks() == 0)
+		return nullptr;
+
+	statistics.count(&DequeCounters::blockReuses);
+	return *--reservedEnd;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::push_back(const T& value)
+{
+	emplace_back(value);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::push_back(T&& value)
+{
+	emplace_back(std::move(value));
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::push_front(const T& value)
+{
+	emplace_front(value);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::push_front(T&& value)
+{
+	emplace_front(std::move(value));
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<typename... Args>
+T& Deque<T, BlockBytes, Allocator, Stats>::emplace_back(Args&&... args)
+{
+	if (lastBlockIndex < mLastValidIndex)  //if there is room in the last block,the element is constructed right after the last element.An empty deque has lastBlockIndex == mEmptyIndex and goes to the cold path
+	{
+		if (sharesBlocks.load(std::memory_order_relaxed))
+			unshareBlock(lastNode);
+		T* element = (*lastNode)->data() + lastBlockIndex + 1;
+		AllocatorTraits::construct(allocator, element, std::forward<Args>(args)...);
+		lastBlockIndex++;
+		return *element;
+	}
+
+	return emplaceBackInNewBlock(std::forward<Args>(args)...);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<typename... Args>
+T& Deque<T, BlockBytes, Allocator, Stats>::emplaceBackInNewBlock(Args&&... args)
+{
+	//the element goes to the start of the next block,either because the deque is empty or because the last block is full.An idle block is used if there is one,and the deque is only updated after the element was constructed,so a throwing constructor leaves it unchanged
+	Block** node = firstNode == nullptr ? emptySplit() : lastNode + 1;
+	if (node == reservedEnd)
+	{
+		reserveMapAtBack(1);
+		Block* block = firstNode != nullptr ? takeIdleFrontBlock() : nullptr;
+		*reservedEnd++ = block != nullptr ? block : allocateBlock();
+		node = reservedEnd - 1;
+	}
+
+	T* element = (*node)->data();
+	try
+	{
+		AllocatorTraits::construct(allocator, element, std::forward<Args>(args)...);
+	}
+	catch (...)
+	{
+		trimIdleBlocks();
+		throw;
+	}
+
+	if (firstNode == nullptr)  //the first block of an empty deque gets the element at its start
+	{
+		firstNode = node;
+		firstBlockIndex = mInitialIndex;
+	}
+	lastNode = node;
+	lastBlockIndex = mInitialIndex;
+	return *element;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<typename... Args>
+T& Deque<T, BlockBytes, Allocator, Stats>::emplace_front(Args&&... args)
+{
+	if (firstBlockIndex - 1 < mLastValidIndex)  //if there is room in the first block,the element is constructed right before the first element.A first element at the start of its block wraps around to the largest index,and an empty deque has firstBlockIndex - 1 == mLastValidIndex,so both go to the cold path
+	{
+		if (sharesBlocks.load(std::memory_order_relaxed))
+			unshareBlock(firstNode);
+		T* element = (*firstNode)->data() + firstBlockIndex - 1;
+		AllocatorTraits::construct(allocator, element, std::forward<Args>(args)...);
+		firstBlockIndex--;
+		return *element;
+	}
+
+	return emplaceFrontInNewBlock(std::forward<Args>(args)...);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<typename... Args>
+T& Deque<T, BlockBytes, Allocator, Stats>::emplaceFrontInNewBlock(Args&&... args)
+{
+	Block** node = firstNode == nullptr ? emptySplit() : firstNode;
+	if (node == reservedBegin)
+	{
+		reserveMapAtFront(1);
+		Block* block = firstNode != nullptr ? takeIdleBackBlock() : nullptr;
+		*--reservedBegin = block != nullptr ? block : allocateBlock();
+		node = reservedBegin + 1;
+	}
+	--node;
+
+	T* element = (*node)->data() + mLastValidIndex;
+	try
+	{
+		AllocatorTraits::construct(allocator, element, std::forward<Args>(args)...);
+	}
+	catch (...)
+	{
+		trimIdleBlocks();
+		throw;
+	}
+
+	if (firstNode == nullptr)  //the first block of an empty deque gets the element at its end
+	{
+		lastNode = node;
+		lastBlockIndex = mLastValidIndex;
+	}
+	firstNode = node;
+	firstBlockIndex = mLastValidIndex;
+	return *element;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::pop_back()
+{
+	if (lastBlockIndex - 1 < mLastValidIndex && lastBlockIndex != firstBlockIndex)  //the last element isn't the only one of its block or of the deque,so it is dropped from the range.An empty deque fails the first check like a last element at the start of its block
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)  //an element without a destructor is only dropped from the range,so a shared block doesn't have to be cloned for it
+		{
+			if (sharesBlocks.load(std::memory_order_relaxed))
+				unshareBlock(lastNode);
+			AllocatorTraits::destroy(allocator, (*lastNode)->data() + lastBlockIndex);
+		}
+		lastBlockIndex--;
+		return;
+	}
+
+	popBackAcrossBlocks();
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::popBackAcrossBlocks()
+{
+	if (empty())
+		return;
+
+	if (firstNode == lastNode && firstBlockIndex == lastBlockIndex)  //if the only element of the deque is popped,the deque becomes empty
+	{
+		clear();
+		return;
+	}
+
+	if (lastBlockIndex == mInitialIndex)  //if the only element of the last block is popped,the block becomes idle and the previous block becomes the last block
+	{
+		Block** node = lastNode--;
+		lastBlockIndex = mLastValidIndex;
+		if (dropReference(*node))
+		{
+			AllocatorTraits::destroy(allocator, (*node)->data());
+		}
+		else  //the block stays with the deques that share it,the outermost idle block takes its slot
+		{
+			*node = *(reservedEnd - 1);
+			--reservedEnd;
+		}
+		trimIdleBlocks();
+	}
+	else  //the first and the last block are different blocks that happen to use the same index,which the fast path doesn't tell apart from a single element
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			if (sharesBlocks.load(std::memory_order_relaxed))
+				unshareBlock(lastNode);
+			AllocatorTraits::destroy(allocator, (*lastNode)->data() + lastBlockIndex);
+		}
+		lastBlockIndex--;
+	}
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::pop_front()
+{
+	if (firstBlockIndex < mLastValidIndex && firstBlockIndex != lastBlockIndex)
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			if (sharesBlocks.load(std::memory_order_relaxed))
+				unshareBlock(firstNode);
+			AllocatorTraits::destroy(allocator, (*firstNode)->data() + firstBlockIndex);
+		}
+		firstBlockIndex++;
+		return;
+	}
+
+	popFrontAcrossBlocks();
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::popFrontAcrossBlocks()
+{
+	if (empty())
+		return;
+
+	if (firstNode == lastNode && firstBlockIndex == lastBlockIndex)  //if the only element of the deque is popped,the deque becomes empty
+	{
+		clear();
+		return;
+	}
+
+	if (firstBlockIndex == mLastValidIndex)  //if the only element of the first block is popped,the block becomes idle and the next block becomes the first block
+	{
+		Block** node = firstNode++;
+		firstBlockIndex = mInitialIndex;
+		if (dropReference(*node))
+		{
+			AllocatorTraits::destroy(allocator, (*node)->data() + mLastValidIndex);
+		}
+		else
+		{
+			*node = *reservedBegin;
+			++reservedBegin;
+		}
+		trimIdleBlocks();
+	}
+	else
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			if (sharesBlocks.load(std::memory_order_relaxed))
+				unshareBlock(firstNode);
+			AllocatorTraits::destroy(allocator, (*firstNode)->data() + firstBlockIndex);
+		}
+		firstBlockIndex++;
+	}
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::pop_front_n(std::size_t count)
+{
+	std::size_t dequeSize = size();
+	if (count >= dequeSize)
+	{
+		clear();
+		return;
+	}
+	if (count == 0)
+		return;
+
+	std::size_t position = firstBlockIndex + count;  //the new first element counted from the start of the first block
+	Block** newFirstNode = firstNode + blockNumber(position);
+	for (Block** node = firstNode; node != newFirstNode; ++node)  //the emptied blocks become idle blocks in front of the deque like in pop_front
+	{
+		if (dropReference(*node))
+		{
+			std::size_t first = node == firstNode ? firstBlockIndex : mInitialIndex;
+			if constexpr (!std::is_trivially_destructible_v<T>)
+			{
+				for (T* element = (*node)->data() + first; element != (*node)->data() + mBlockSize; ++element)
+					AllocatorTraits::destroy(allocator, element);
+			}
+		}
+		else
+		{
+			*node = *reservedBegin;
+			++reservedBegin;
+		}
+	}
+
+	std::size_t newFirstIndex = offsetInBlock(position);
+	if (newFirstNode != firstNode)
+	{
+		firstNode = newFirstNode;
+		firstBlockIndex = mInitialIndex;
+	}
+	if constexpr (!std::is_trivially_destructible_v<T>)
+	{
+		if (sharesBlocks.load(std::memory_order_relaxed))
+			unshareBlock(firstNode);
+		for (T* element = (*firstNode)->data() + firstBlockIndex; element != (*firstNode)->data() + newFirstIndex; ++element)
+			AllocatorTraits::destroy(allocator, element);
+	}
+	firstBlockIndex = newFirstIndex;
+	trimIdleBlocks();
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::pop_back_n(std::size_t count)
+{
+	std::size_t dequeSize = size();
+	if (count >= dequeSize)
+	{
+		clear();
+		return;
+	}
+	if (count == 0)
+		return;
+
+	std::size_t position = firstBlockIndex + dequeSize - count - 1;  //the new last element counted from the start of the first block
+	Block** newLastNode = firstNode + blockNumber(position);
+	for (Block** node = lastNode; node != newLastNode; --node)
+	{
+		if (dropReference(*node))
+		{
+			std::size_t last = node == lastNode ? lastBlockIndex + 1 : mBlockSize;
+			if constexpr (!std::is_trivially_destructible_v<T>)
+			{
+				for (T* element = (*node)->data(); element != (*node)->data() + last; ++element)
+					AllocatorTraits::destroy(allocator, element);
+			}
+		}
+		else
+		{
+			*node = *(reservedEnd - 1);
+			--reservedEnd;
+		}
+	}
+
+	std::size_t newLastIndex = offsetInBlock(position);
+	if (newLastNode != lastNode)
+	{
+		lastNode = newLastNode;
+		lastBlockIndex = mLastValidIndex;
+	}
+	if constexpr (!std::is_trivially_destructible_v<T>)
+	{
+		if (sharesBlocks.load(std::memory_order_relaxed))
+			unshareBlock(lastNode);
+		for (T* element = (*lastNode)->data() + newLastIndex + 1; element != (*lastNode)->data() + lastBlockIndex + 1; ++element)
+			AllocatorTraits::destroy(allocator, element);
+	}
+	lastBlockIndex = newLastIndex;
+	trimIdleBlocks();
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<typename OutputIterator>
+OutputIterator Deque<T, BlockBytes, Allocator, Stats>::drain_front(OutputIterator output, std::size_t count)
+{
+	count = std::min(count, size());
+	std::size_t position = firstBlockIndex;
+	std::size_t endPosition = firstBlockIndex + count;
+	while (position < endPosition)  //one block slice at a time,the elements are removed together at the end
+	{
+		std::size_t offset = offsetInBlock(position);
+		std::size_t length = std::min(mBlockSize - offset, endPosition - position);
+		Block* block = firstNode[blockNumber(position)];
+		T* segment = block->data() + offset;
+		if constexpr (mCopiesBytes<OutputIterator>)
+		{
+			std::memcpy(static_cast<void*>(std::to_address(output)), segment, length * sizeof(T));
+			output += length;
+		}
+		else
+		{
+			if (block->references.load(std::memory_order_acquire) == 1)
+				output = std::move(segment, segment + length, output);
+			else
+				output = std::copy(segment, segment + length, output);
+		}
+		position += length;
+	}
+
+	pop_front_n(count);
+	return output;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<typename Function>
+std::size_t Deque<T, BlockBytes, Allocator, Stats>::consume_front(std::size_t count, Function function)
+{
+	count = std::min(count, size());
+	unshareRange(0, count);  //the function gets writable elements
+	forEachSegment(0, count, [&function](T* segmentBegin, T* segmentEnd) { function(std::span<T>(segmentBegin, segmentEnd - segmentBegin)); });
+	pop_front_n(count);
+	return count;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+T& Deque<T, BlockBytes, Allocator, Stats>::front()
+{
+	if (empty())
+		throw std::out_of_range("Deque is empty, cannot access front element.");
+
+	if (sharesBlocks.load(std::memory_order_relaxed))  //the element can be written through the reference
+		unshareBlock(firstNode);
+	return (*firstNode)->data()[firstBlockIndex];
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+const T& Deque<T, BlockBytes, Allocator, Stats>::front() const
+{
+	if (empty())
+		throw std::out_of_range("Deque is empty, cannot access front element.");
+
+	return (*firstNode)->data()[firstBlockIndex];
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+T& Deque<T, BlockBytes, Allocator, Stats>::back()
+{
+	if (empty())
+		throw std::out_of_range("Deque is empty, cannot access back element.");
+
+	if (sharesBlocks.load(std::memory_order_relaxed))
+		unshareBlock(lastNode);
+	return (*lastNode)->data()[lastBlockIndex];
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+const T& Deque<T, BlockBytes, Allocator, Stats>::back() const
+{
+	if (empty())
+		throw std::out_of_range("Deque is empty, cannot access back element.");
+
+	return (*lastNode)->data()[lastBlockIndex];
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+T& Deque<T, BlockBytes, Allocator, Stats>::operator[](std::size_t index)
+{
+	std::size_t dequeSize = size();
+
+	if (index >= dequeSize)
+	{
+		if (dequeSize == 0)  //either the deque is empty
+		{
+			throw std::out_of_range("Trying to access empty deque");
+		}
+		else  //or the index is out of range
+		{
+			clear();
+			throw std::out_of_range("Index out of range");
+		}
+	}
+
+	if (sharesBlocks.load(std::memory_order_relaxed))  //the element can be written through the reference
+		unshareRange(index, index + 1);
+	return elementAt(index);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+const T& Deque<T, BlockBytes, Allocator, Stats>::operator[](std::size_t index) const
+{
+	std::size_t dequeSize = size();
+
+	if (index >= dequeSize)  //a const deque can't be cleared,so only the exception is thrown
+	{
+		if (dequeSize == 0)
+			throw std::out_of_range("Trying to access empty deque");
+		else
+			throw std::out_of_range("Index out of range");
+	}
+
+	return elementAt(index);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+bool Deque<T, BlockBytes, Allocator, Stats>::empty() const
+{
+	return firstNode == nullptr;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::clear()
+{
+	emptyBlocks();
+	trimIdleBlocks();
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+std::size_t Deque<T, BlockBytes, Allocator, Stats>::size() const
+{
+	if (empty())
+		return 0;
+
+	return (lastNode - firstNode) * mBlockSize + lastBlockIndex + 1 - firstBlockIndex;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+constexpr std::size_t Deque<T, BlockBytes, Allocator, Stats>::blockNumber(std::size_t position)
+{
+	if constexpr (mBlockSizeIsPowerOfTwo)  //when the block size is a power of two the division is a shift
+		return position >> mBlockShift;
+	else
+		return position / mBlockSize;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+constexpr std::size_t Deque<T, BlockBytes, Allocator, Stats>::offsetInBlock(std::size_t position)
+{
+	if constexpr (mBlockSizeIsPowerOfTwo)  //and the remainder is a mask
+		return position & (mBlockSize - 1);
+	else
+		return position % mBlockSize;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+T& Deque<T, BlockBytes, Allocator, Stats>::elementAt(std::size_t index)
+{
+	std::size_t position = firstBlockIndex + index;  //the position of the element counted from the start of the first block,every block is full apart from the first and the last one
+	return firstNode[blockNumber(position)]->data()[offsetInBlock(position)];
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+const T& Deque<T, BlockBytes, Allocator, Stats>::elementAt(std::size_t index) const
+{
+	std::size_t position = firstBlockIndex + index;
+	return firstNode[blockNumber(position)]->data()[offsetInBlock(position)];
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<typename Function>
+void Deque<T, BlockBytes, Allocator, Stats>::forEachSegment(std::size_t first, std::size_t last, Function function)
+{
+	std::size_t position = firstBlockIndex + first;
+	std::size_t endPosition = firstBlockIndex + last;
+	while (position < endPosition)  //the function is called once for every block with the contiguous part of [first, last) that is stored in it
+	{
+		std::size_t offset = offsetInBlock(position);
+		std::size_t length = std::min(mBlockSize - offset, endPosition - position);
+		Block** node = firstNode + blockNumber(position);
+		if constexpr (mPrefetchDistance > 0)
+			prefetchBlock(node[mPrefetchDistance]);
+		T* segment = (*node)->data() + offset;
+		function(segment, segment + length);
+		position += length;
+	}
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::moveLeft(std::size_t first, std::size_t last, std::size_t destination)
+{
+	std::size_t source = firstBlockIndex + first;
+	std::size_t sourceEnd = firstBlockIndex + last;
+	std::size_t target = firstBlockIndex + destination;
+	statistics.count(&DequeCounters::elementShifts, last - first);
+	while (source < sourceEnd)  //every step moves the longest run that is contiguous both in the source block and in the destination block
+	{
+		std::size_t sourceOffset = offsetInBlock(source);
+		std::size_t targetOffset = offsetInBlock(target);
+		std::size_t length = std::min({ sourceEnd - source, mBlockSize - sourceOffset, mBlockSize - targetOffset });
+		T* sourceSegment = firstNode[blockNumber(source)]->data() + sourceOffset;
+		std::move(sourceSegment, sourceSegment + length, firstNode[blockNumber(target)]->data() + targetOffset);
+		source += length;
+		target += length;
+	}
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::moveRight(std::size_t first, std::size_t last, std::size_t destinationEnd)
+{
+	std::size_t source = firstBlockIndex + first;
+	std::size_t sourceEnd = firstBlockIndex + last;
+	std::size_t targetEnd = firstBlockIndex + destinationEnd;
+	statistics.count(&DequeCounters::elementShifts, last - first);
+	while (sourceEnd > source)  //same as moveLeft but going from the back,so the ranges can overlap
+	{
+		std::size_t sourceOffset = offsetInBlock(sourceEnd - 1) + 1;
+		std::size_t targetOffset = offsetInBlock(targetEnd - 1) + 1;
+		std::size_t length = std::min({ sourceEnd - source, sourceOffset, targetOffset });
+		T* sourceSegment = firstNode[blockNumber(sourceEnd - 1)]->data() + sourceOffset;
+		std::move_backward(sourceSegment - length, sourceSegment, firstNode[blockNumber(targetEnd - 1)]->data() + targetOffset);
+		sourceEnd -= length;
+		targetEnd -= length;
+	}
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::openGap(std::size_t index, std::size_t count, const T& placeholder)
+{
+	std::size_t dequeSize = size();
+	if (index < dequeSize - index)  //the gap is opened on the side with fewer elements,so at most half of the deque is shifted
+	{
+		for (std::size_t i = 0; i < count; i++)
+			push_front(placeholder);
+		unshareRange(0, count + index);  //the blocks the elements are moved through are written
+		moveLeft(count, count + index, 0);
+	}
+	else
+	{
+		for (std::size_t i = 0; i < count; i++)
+			push_back(placeholder);
+		unshareRange(index, dequeSize + count);
+		moveRight(index, dequeSize, dequeSize + count);
+	}
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::allocateBlocks(Block** first, Block** last)
+{
+	Block** node = first;
+	try
+	{
+		for (; node != last; ++node)
+			*node = allocateBlock();
+	}
+	catch (...)  //the blocks allocated before the failure are given back,so the directory slots are unused again
+	{
+		deallocateBlocks(first, node);
+		throw;
+	}
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::deallocateBlocks(Block** first, Block** last)
+{
+	for (Block** node = first; node != last; ++node)
+		deallocateBlock(*node);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<typename ForwardIterator>
+void Deque<T, BlockBytes, Allocator, Stats>::constructElements(Block** node, std::size_t blockIndex, std::size_t count, ForwardIterator first)
+{
+	std::size_t constructed = 0;
+	try
+	{
+		while (constructed < count)  //the range is copied one block slice at a time
+		{
+			std::size_t position = blockIndex + constructed;
+			std::size_t offset = offsetInBlock(position);
+			std::size_t length = std::min(mBlockSize - offset, count - constructed);
+			T* segment = node[blockNumber(position)]->data() + offset;
+			if constexpr (mCopiesBytes<ForwardIterator>)
+			{
+				std::memcpy(static_cast<void*>(segment), std::addressof(*first), length * sizeof(T));
+				first += length;
+				constructed += length;
+			}
+			else
+			{
+				for (T* element = segment; element != segment + length; ++element, ++first, ++constructed)
+					AllocatorTraits::construct(allocator, element, *first);
+			}
+		}
+	}
+	catch (...)  //the elements constructed before the failure are destroyed,so the caller only has to release its blocks
+	{
+		for (std::size_t i = 0; i < constructed; i++)
+			AllocatorTraits::destroy(allocator, node[blockNumber(blockIndex + i)]->data() + offsetInBlock(blockIndex + i));
+		throw;
+	}
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::relocateElements(Block* source, Block* target, std::size_t first, std::size_t last)
+{
+	//the elements [first, last) move to the same positions in target,only used where moving an element can't throw
+	if constexpr (std::is_trivially_copyable_v<T>)
+	{
+		std::memcpy(static_cast<void*>(target->data() + first), source->data() + first, (last - first) * sizeof(T));
+	}
+	else
+	{
+		for (std::size_t index = first; index < last; index++)
+		{
+			AllocatorTraits::construct(allocator, target->data() + index, std::move(source->data()[index]));
+			AllocatorTraits::destroy(allocator, source->data() + index);
+		}
+	}
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+typename Deque<T, BlockBytes, Allocator, Stats>::Block** Deque<T, BlockBytes, Allocator, Stats>::openNodesAtBack(std::size_t count)
+{
+	//makes room for count directory slots right after the used part,or at the empty split,by moving the idle blocks behind it back.The slots are returned unfilled
+	reserveMapAtBack(count);
+	Block** node = firstNode != nullptr ? lastNode + 1 : emptySplit();
+	std::copy_backward(node, reservedEnd, reservedEnd + count);
+	reservedEnd += count;
+	return node;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+typename Deque<T, BlockBytes, Allocator, Stats>::Block** Deque<T, BlockBytes, Allocator, Stats>::openNodesAtFront(std::size_t count)
+{
+	reserveMapAtFront(count);
+	Block** node = firstNode != nullptr ? firstNode : emptySplit();
+	std::copy(reservedBegin, node, reservedBegin - count);
+	reservedBegin -= count;
+	return node - count;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::swapDirectories(Deque& other)
+{
+	//the deques trade their directories with the blocks in them and keep their own reserves and spare blocks
+	std::swap(blockMap, other.blockMap);
+	std::swap(mapCapacity, other.mapCapacity);
+	std::swap(firstNode, other.firstNode);
+	std::swap(lastNode, other.lastNode);
+	std::swap(firstBlockIndex, other.firstBlockIndex);
+	std::swap(lastBlockIndex, other.lastBlockIndex);
+	std::swap(reservedBegin, other.reservedBegin);
+	std::swap(reservedEnd, other.reservedEnd);
+	bool otherSharesBlocks = other.sharesBlocks.load(std::memory_order_relaxed);
+	other.sharesBlocks.store(sharesBlocks.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	sharesBlocks.store(otherSharesBlocks, std::memory_order_relaxed);
+	trimIdleBlocks();
+	other.trimIdleBlocks();
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::forgetUsedBlocks()
+{
+	//the used blocks were handed to another deque or freed,the idle blocks behind them close the gap and the deque is empty
+	reservedEnd = std::copy(lastNode + 1, reservedEnd, firstNode);
+	firstNode = nullptr;
+	lastNode = nullptr;
+	firstBlockIndex = mEmptyIndex;
+	lastBlockIndex = mEmptyIndex;
+	sharesBlocks.store(false, std::memory_order_relaxed);
+	trimIdleBlocks();
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::readElements(std::istream& stream, Block** node, std::size_t count)
+{
+	std::size_t constructed = 0;
+	try
+	{
+		while (constructed < count)  //the elements are read one block at a time,starting at the beginning of the first block
+		{
+			std::size_t length = std::min(mBlockSize, count - constructed);
+			T* segment = node[blockNumber(constructed)]->data();
+			if constexpr (DequeSerializable<T>)
+			{
+				for (T* element = segment; element != segment + length; ++element)
+				{
+					AllocatorTraits::construct(allocator, element, DequeSerializer<T>::read(stream));
+					constructed++;
+					if (!stream)
+						throw std::runtime_error("Deque stream is truncated");
+				}
+			}
+			else
+			{
+				if (!stream.read(reinterpret_cast<char*>(segment), static_cast<std::streamsize>(length * sizeof(T))))
+					throw std::runtime_error("Deque stream is truncated");
+				constructed += length;
+			}
+		}
+	}
+	catch (...)
+	{
+		for (std::size_t i = 0; i < constructed; i++)
+			AllocatorTraits::destroy(allocator, node[blockNumber(i)]->data() + offsetInBlock(i));
+		throw;
+	}
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::insert(const T& value, std::size_t index)
+{
+	insert(index, 1, value);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::insert(std::size_t index, std::size_t count, const T& value)
+{
+	if (index > size())  //invalid index handling
+	{
+		clear();
+		throw std::out_of_range("Index out of range");
+	}
+
+	if (count == 0)
+		return;
+
+	T valueCopy = value;  //the value could be an element of this deque that is moved when the gap is opened
+	openGap(index, count, valueCopy);
+	forEachSegment(index, index + count, [&valueCopy](T* segmentBegin, T* segmentEnd) { std::fill(segmentBegin, segmentEnd, valueCopy); });
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<typename InputIterator, typename>
+void Deque<T, BlockBytes, Allocator, Stats>::insert(std::size_t index, InputIterator first, InputIterator last)
+{
+	if (index > size())  //invalid index handling
 	{
-		Block* newBlock = new Block;
-		newBlock->data = block->data;
-		if (blockAddresses.empty() && firstBlockIndex != mBlockSize)
-			blockAddresses.push_front(newBlock);
-		else
-			blockAddresses.push_back(newBlock);
+		clear();
+		throw std::out_of_range("Index out of range");
 	}
 
-	//make the prev-next connections
-	auto prevIt = blockAddresses.begin();
-	for (auto it = std::next(prevIt); it != blockAddresses.end(); ++it, ++prevIt)
+	using Category = typename std::iterator_traits<InputIterator>::iterator_category;
+	if constexpr (!std::is_base_of_v<std::forward_iterator_tag, Category>)  //a single pass range can't be measured before it is read,so it is buffered first
 	{
-		(*prevIt)->next = (*it);
-		(*it)->previous = (*prevIt);
+		std::vector<T> buffer(first, last);
+		insert(index, buffer.begin(), buffer.end());
 	}
+	else
+	{
+		std::size_t count = std::distance(first, last);
+		if (count == 0)
+			return;
 
-	if (other.firstBlock != nullptr)
-		firstBlock = blockAddresses.front();
-	if (other.lastBlock != nullptr)
-		lastBlock = blockAddresses.back();
-
-	firstBlockIndex = other.firstBlockIndex;
-	lastBlockIndex = other.lastBlockIndex;
-
-	return *this;
+		openGap(index, count, *first);
+		forEachSegment(index, index + count, [&first](T* segmentBegin, T* segmentEnd)
+		{
+			for (T* element = segmentBegin; element != segmentEnd; ++element, ++first)
+				*element = *first;
+		});
+	}
 }
 
-template<typename T>
-Deque<T>::Deque() : firstBlock(nullptr), lastBlock(nullptr), firstBlockIndex(mBlockSize), lastBlockIndex(mInitialIndex - 1) {}
-
-template<typename T>
-Deque<T>::Deque(const Deque& other)
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::remove(std::size_t index)
 {
-	*this = other;
+	if (index >= size())  //invalid index handling
+	{
+		clear();
+		throw std::out_of_range("Index out of range");
+	}
+
+	erase(index, index + 1);
 }
 
-template<typename T>
-void Deque<T>::push_back(const T& value)
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::erase(std::size_t first, std::size_t last)
 {
-	if (lastBlockIndex == mLastValidIndex)  //for the case of push_back in a full array,a new block is created
+	std::size_t dequeSize = size();
+	if (first > last || last > dequeSize)  //invalid range handling
 	{
-		Block* newBlock = new Block;  //make a new block
-		newBlock->previous = lastBlock;  //update the conection between the new block and the block that was previously last
-		lastBlock->next = newBlock;
-		newBlock->next = nullptr;
-		lastBlock = newBlock;  //update the pointer to the last block
-		lastBlockIndex = mInitialIndex - 1;  //update the pointer to the last element of the last block
-		blockAddresses.push_back(newBlock);
-
-		if (firstBlock == nullptr)  //if there is no firstBlock but there is a full block and a last block,then the full block becomes the firstBlock
-		{
-			firstBlock = blockAddresses.front();
-			Block* tempAddress = blockAddresses.front();  //this is used to make the connections between the new firstBlock and the block after it
-			tempAddress = tempAddress->next;  //now tempAddress has the address of the next block after the firstBlock
-			Block*& nextBlockAfterFirstBlock = tempAddress;  //used a reference so that i can update the block after the firstBlock's previous
-			firstBlock->next = nextBlockAfterFirstBlock;
-			nextBlockAfterFirstBlock->previous = firstBlock;
-			firstBlockIndex = mInitialIndex;  //the block is full so the index points at the last element,which in the firstBlock is index 0
-		}
+		clear();
+		throw std::out_of_range("Index out of range");
 	}
-	else if (lastBlock == nullptr && firstBlock != nullptr)  //if there is a first block but there is no last block,the lastBlock is created and the element in inserted in it
+
+	std::size_t count = last - first;
+	if (count == 0)
+		return;
+
+	if (first < dequeSize - last)  //the gap is closed from the side with fewer elements
 	{
-		Block* newLastBlock = new Block;  //make a new block
-		newLastBlock->previous = blockAddresses.back();  //update the conection between the new block and the block that was previously last
-		Block*& lastFirstBlock = blockAddresses.back();  //this is is the block from the front that is closest to the middle
-		lastFirstBlock->next = newLastBlock;
-		lastBlock = newLastBlock;  //update the pointer to the last block
-		lastBlockIndex = mInitialIndex - 1;  //update the pointer to the last element of the last block
-		blockAddresses.push_back(newLastBlock);
+		unshareRange(0, last);
+		moveRight(0, first, last);
+		pop_front_n(count);
 	}
-	else if (lastBlock == nullptr && firstBlock == nullptr)  //if the dequeue does not have a lastBlock or a firstBlock,the lastBlock is created
+	else
 	{
-		Block* newLastBlock = new Block;  //make a new lastBlock
-		//newLastBlock->previous = newFirstBlock;  //update the conection between the firstBlock and lastBlock
-		newLastBlock->next = nullptr;
-		lastBlockIndex = mInitialIndex - 1;  //update the pointer to the last element of the last block
-		lastBlock = newLastBlock;  //update the pointer to the last block
-		blockAddresses.push_back(newLastBlock);
+		unshareRange(first, dequeSize);
+		moveLeft(last, dequeSize, first);
+		pop_back_n(count);
 	}
-	lastBlockIndex++;  //the lastBlockIndex points to the last element of the deque.At first it it initialized with -1 because there are no elements in the deque for it to point to.This way i increment it first and add the value in the deque at the incremented value
-	lastBlock->data[lastBlockIndex] = value;
 }
 
-template<typename T>
-void Deque<T>::push_front(const T& value)
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::splice_back(Deque&& other)
 {
-	if (firstBlockIndex == mInitialIndex)		//for the case of push_front in a full block,a new block is made
+	if (&other == this || other.firstNode == nullptr)
+		return;
+
+	if (!AllocatorTraits::is_always_equal::value && !(allocator == other.allocator))  //a block has to be freed by the allocator that allocated it,so the elements are moved instead
 	{
-		Block* newBlock = new Block;  //make a new block
-		firstBlock->previous = newBlock;  //update the conection between the new block and the previous first block
-		newBlock->previous = nullptr;
-		newBlock->next = firstBlock;
-		firstBlock = newBlock;  //update the pointer to the first block
-		firstBlockIndex = mBlockSize;  //update the pointer to the last element of the first block
-		blockAddresses.push_front(newBlock);
+		append(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+		other.clear();
+		return;
+	}
 
-		if (lastBlock == nullptr)  //if there is no lastBlock but there is a full block and a first block,then the full block becomes the lastBlock
+	if (firstNode != nullptr && ((lastBlockIndex + 1) % mBlockSize != other.firstBlockIndex || !std::is_nothrow_move_constructible_v<T>))
+	{
+		if (size() >= other.size())
 		{
-			lastBlock = blockAddresses.back();
-			Block* tempAddress = blockAddresses.back();  //this is used to make the connections between the new lastBlock and the block before it
-			tempAddress = tempAddress->previous;  //now tempAddress has the address of the previous block before the lastBlock
-			Block*& previousBlockBeforeLastBlock = tempAddress;  //used a reference so that i can update the block after the firstBlock's previous
-			lastBlock->previous = previousBlockBeforeLastBlock;
-			previousBlockBeforeLastBlock->next = lastBlock;
-			lastBlockIndex = mLastValidIndex;
+			append(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+			other.clear();
+			return;
 		}
+
+		other.prepend(std::make_move_iterator(begin()), std::make_move_iterator(end()));  //this deque is the smaller one,so it moves into other and then takes its blocks
+		clear();
+	}
+
+	if (firstNode == nullptr && reservedBegin == reservedEnd)  //an empty deque without idle blocks takes the whole directory of other
+	{
+		swapDirectories(other);
+		return;
 	}
-	else if (firstBlock == nullptr && lastBlock != nullptr)  //if there is a last block but there is no first block,the firstBlock is created
+
+	//the last block of this deque and the first block of other are one block's worth of positions when the last block isn't full.Everything that can throw is done before the deques are changed
+	bool joinsBlocks = firstNode != nullptr && other.firstBlockIndex != mInitialIndex;
+	if (joinsBlocks && sharesBlocks.load(std::memory_order_relaxed))
+		unshareBlock(lastNode);
+	if (joinsBlocks && other.sharesBlocks.load(std::memory_order_relaxed))
+		other.unshareBlock(other.firstNode);
+	Block** movedFirst = joinsBlocks ? other.firstNode + 1 : other.firstNode;
+	Block** node = openNodesAtBack(other.lastNode + 1 - movedFirst);
+
+	if (joinsBlocks)
 	{
-		Block* newFirstBlock = new Block;  //make a new block
-		newFirstBlock->next = blockAddresses.front();  //update the conection between the new block and the block that was from the last blocks the closest to the middle
-		Block*& firstLastBlock = blockAddresses.front();  //this is is the block from the end that is closest to the middle
-		firstLastBlock->previous = newFirstBlock;
-		firstBlock = newFirstBlock;  //update the pointer to the first block
-		firstBlockIndex = mBlockSize;  //update the pointer to the last element of the last block
-		blockAddresses.push_front(newFirstBlock);
+		std::size_t ownFirst = firstNode == lastNode ? firstBlockIndex : mInitialIndex;
+		std::size_t otherLast = other.firstNode == other.lastNode ? other.lastBlockIndex + 1 : mBlockSize;
+		if (otherLast - other.firstBlockIndex <= lastBlockIndex + 1 - ownFirst)
+		{
+			relocateElements(*other.firstNode, *lastNode, other.firstBlockIndex, otherLast);
+			deallocateBlock(*other.firstNode);
+		}
+		else
+		{
+			relocateElements(*lastNode, *other.firstNode, ownFirst, lastBlockIndex + 1);
+			deallocateBlock(*lastNode);
+			*lastNode = *other.firstNode;
+		}
 	}
-	else if (firstBlock == nullptr) //if the dequeue is does not have a firstBlock or a lastBlock,a firstBlock is created
+
+	std::copy(movedFirst, other.lastNode + 1, node);
+	if (firstNode == nullptr)
 	{
-		Block* newFirstBlock = new Block;  //make a new firstBlock
-		/*newFirstBlock->next = newLastBlock;*/
-		newFirstBlock->previous = nullptr;
-		firstBlockIndex = mBlockSize;  //update the pointer to the last element of the first block
-		firstBlock = newFirstBlock;  //update the pointer to the first block
-		blockAddresses.push_front(newFirstBlock);
+		firstNode = node;
+		firstBlockIndex = other.firstBlockIndex;
 	}
-	firstBlockIndex--;
-	firstBlock->data[firstBlockIndex] = value;
+	lastNode = node + (other.lastNode - movedFirst);
+	lastBlockIndex = other.lastBlockIndex;
+	if (other.sharesBlocks.load(std::memory_order_relaxed))
+		sharesBlocks.store(true, std::memory_order_relaxed);
+
+	other.forgetUsedBlocks();
+	trimIdleBlocks();
 }
 
-template<typename T>
-void Deque<T>::pop_back()
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+void Deque<T, BlockBytes, Allocator, Stats>::splice_front(Deque&& other)
 {
-	if (empty())
+	if (&other == this || other.firstNode == nullptr)
+		return;
+
+	if (!AllocatorTraits::is_always_equal::value && !(allocator == other.allocator))
 	{
+		prepend(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+		other.clear();
 		return;
 	}
-	else if (firstBlock != nullptr && lastBlock == nullptr)  //if there is only one block and it is the front block  (the condition is correct to check if there is only the firstBlock in the deque because if there are 2 blocks created with push_front() then the one that is filled becomes lastBlock so if there is a firstBlock but no lastBlock,then there is only 1 block and that is the firstBlock)
-	{
-		if (firstBlockIndex == mLastValidIndex)  //if there is only one element in the firstBlock and it is being deleted,the deque becomes empty
-		{
-			firstBlock->previous = nullptr;
-			firstBlock->next = nullptr;
-			firstBlock = nullptr;
 
-			Block* tempAddress = blockAddresses.front();
-			blockAddresses.pop_front();
-			delete tempAddress;
-		}
-		else  //delete the last element from the firstBlock
+	if (firstNode != nullptr && ((other.lastBlockIndex + 1) % mBlockSize != firstBlockIndex || !std::is_nothrow_move_constructible_v<T>))
+	{
+		if (size() >= other.size())
 		{
-			for (int i = mLastValidIndex; i > firstBlockIndex; i--)
-				firstBlock->data[i] = firstBlock->data[i - 1];
-			firstBlockIndex++;
+			prepend(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+			other.clear();
+			return;
 		}
+
+		other.append(std::make_move_iterator(begin()), std::make_move_iterator(end()));
+		clear();
+	}
+
+	if (firstNode == nullptr && reservedBegin == reservedEnd)
+	{
+		swapDirectories(other);
+		return;
 	}
-	else  //if there is a lastBlock
+
+	bool joinsBlocks = firstNode != nullptr && firstBlockIndex != mInitialIndex;
+	if (joinsBlocks && sharesBlocks.load(std::memory_order_relaxed))
+		unshareBlock(firstNode);
+	if (joinsBlocks && other.sharesBlocks.load(std::memory_order_relaxed))
+		other.unshareBlock(other.lastNode);
+	Block** movedLast = joinsBlocks ? other.lastNode : other.lastNode + 1;
+	Block** node = openNodesAtFront(movedLast - other.firstNode);
+
+	if (joinsBlocks)
 	{
-		if (lastBlockIndex == mInitialIndex)  //if i am popping the only element in a block,the block gets deleted and there are 2 cases:either there is another block apart from the firstBlock or there are noBlocks(or only the firstBlock) and in that case there is no longer a lastBlock
+		std::size_t ownLast = firstNode == lastNode ? lastBlockIndex + 1 : mBlockSize;
+		std::size_t otherFirst = other.firstNode == other.lastNode ? other.firstBlockIndex : mInitialIndex;
+		if (other.lastBlockIndex + 1 - otherFirst <= ownLast - firstBlockIndex)
 		{
-			if (lastBlock->previous == firstBlock && firstBlock != nullptr)  //if the only block left is the firstBlock
-			{
-				Block* tempAddress = blockAddresses.back();
-				blockAddresses.pop_back();
-				delete tempAddress;
-				lastBlock = nullptr;
-				firstBlock->next = nullptr;
-				lastBlockIndex = mInitialIndex - 1;
-			}
-			else if (lastBlock->previous != nullptr && lastBlock->previous != firstBlock)  //if there is at least one block before the LastBlock that is not the firstBlock,then the block previous to the LastBlock now becomes the lastBlock
-			{
-				lastBlock = lastBlock->previous;
-				lastBlock->next = nullptr;
-				lastBlockIndex = mLastValidIndex;
-				Block* tempAddress = blockAddresses.back();
-				blockAddresses.pop_back();
-				delete tempAddress;
-			}
-			else if (lastBlock->previous == firstBlock && firstBlock == nullptr)  //if there is only one block with one element and it is being popped,then the deque becomes empty
-			{
-				Block* tempAddress = blockAddresses.back();
-				blockAddresses.pop_back();
-				delete tempAddress;
-				lastBlock->previous = nullptr;
-				lastBlock->next = nullptr;
-				lastBlock = nullptr;
-			}
+			relocateElements(*other.lastNode, *firstNode, otherFirst, other.lastBlockIndex + 1);
+			deallocateBlock(*other.lastNode);
 		}
-		else  //if i am popping an element in a block that has elements and doesn't become empty after the pop
+		else
 		{
-			lastBlockIndex--;
+			relocateElements(*firstNode, *other.lastNode, firstBlockIndex, ownLast);
+			deallocateBlock(*firstNode);
+			*firstNode = *other.lastNode;
 		}
 	}
+
+	std::copy(other.firstNode, movedLast, node);
+	if (firstNode == nullptr)
+	{
+		lastNode = node + (movedLast - other.firstNode - 1);
+		lastBlockIndex = other.lastBlockIndex;
+	}
+	firstNode = node;
+	firstBlockIndex = other.firstBlockIndex;
+	if (other.sharesBlocks.load(std::memory_order_relaxed))
+		sharesBlocks.store(true, std::memory_order_relaxed);
+
+	other.forgetUsedBlocks();
+	trimIdleBlocks();
 }
 
-template<typename T>
-void Deque<T>::pop_front()
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+Deque<T, BlockBytes, Allocator, Stats> Deque<T, BlockBytes, Allocator, Stats>::split_at(std::size_t index)
 {
-	if (empty())
+	std::size_t dequeSize = size();
+	if (index > dequeSize)  //invalid index handling
 	{
-		return;
+		clear();
+		throw std::out_of_range("Index out of range");
 	}
-	else if (lastBlock != nullptr && firstBlock == nullptr)  //if there is only one block and it is the last block
+
+	Deque result(allocator);
+	if (index == dequeSize)
+		return result;
+
+	if (index == 0 || !std::is_nothrow_move_constructible_v<T>)
 	{
-		if (lastBlockIndex == mInitialIndex)  //if there is only one element in the lastBlock and it is being deleted,the deque becomes empty
+		if (index == 0)
 		{
-			lastBlock->previous = nullptr;
-			lastBlock->next = nullptr;
-			lastBlock = nullptr;
-
-			Block* tempAddress = blockAddresses.back();
-			blockAddresses.pop_back();
-			delete tempAddress;
+			result.splice_back(std::move(*this));
 		}
-		else  //delete the first element from the lastBlock
+		else
 		{
-			for (int i = mInitialIndex; i < lastBlockIndex; i++)
-				lastBlock->data[i] = lastBlock->data[i + 1];
-			lastBlockIndex--;
+			result.append(std::make_move_iterator(begin() + index), std::make_move_iterator(end()));
+			erase(index, dequeSize);
 		}
+		return result;
 	}
-	else  //if there is a firstBlock
+
+	//the result takes the blocks from the one the index falls in to the last one.If the index is inside a block,the side with fewer elements of that block moves them to a new block at the same positions
+	std::size_t position = firstBlockIndex + index;
+	Block** splitNode = firstNode + blockNumber(position);
+	std::size_t splitIndex = offsetInBlock(position);
+	bool splitsBlock = splitIndex != mInitialIndex;
+	Block* newBlock = nullptr;
+	if (splitsBlock)
 	{
-		if (firstBlockIndex == mLastValidIndex)  //if i am popping the only element in the firstBlock,it gets deleted and there are 2 cases:either there is another block apart from the lastBlock or there are no blocks(or only the lastBlock) and in that case there is no longer a firstBlock 
-		{
-			if (firstBlock->next == lastBlock && lastBlock != nullptr)  //if the only block left is the lastBlock
-			{
-				Block* tempAddress = blockAddresses.front();
-				blockAddresses.pop_front();
-				delete tempAddress;
-				firstBlock = nullptr;
-				lastBlock->previous = nullptr;
-				firstBlockIndex = mBlockSize;
-			}
-			else if (firstBlock->next != nullptr && firstBlock->next != lastBlock)  //if there is at least one block after the firstBlock that is not the lastBlock,then the block next after the firstBlock now becomes the firstBlock
-			{
-				firstBlock = firstBlock->next;
-				firstBlock->previous = nullptr;
-				firstBlockIndex = mInitialIndex;
-				Block* tempAddress = blockAddresses.front();
-				blockAddresses.pop_front();
-				delete tempAddress;
-			}
-			else if (firstBlock->next == lastBlock && lastBlock == nullptr)  //if there is only one block with one element and it is being popped,then the deque becomes empty
-			{
-				Block* tempAddress = blockAddresses.front();
-				blockAddresses.pop_front();
-				delete tempAddress;
-				firstBlock->previous = nullptr;
-				firstBlock->next = nullptr;
-				firstBlock = nullptr;
-			}
-		}
-		else  //if i am popping an element in a block that has elements and doesn't become empty after the pop
-		{
-			firstBlockIndex++;
-		}
+		if (sharesBlocks.load(std::memory_order_relaxed))
+			unshareBlock(splitNode);
+		newBlock = result.allocateBlock();
 	}
-}
 
-template<typename T>
-T& Deque<T>::front()
-{
-	if (blockAddresses.empty())
+	std::size_t blockCount = lastNode - splitNode + 1;
+	Block** node;
+	try
 	{
-		throw std::out_of_range("Deque is empty, cannot access front element.");
+		node = result.openNodesAtBack(blockCount);
 	}
-	else
+	catch (...)
+	{
+		if (newBlock != nullptr)
+			result.deallocateBlock(newBlock);
+		throw;
+	}
+
+	std::copy(splitNode, lastNode + 1, node);
+	result.firstNode = node;
+	result.lastNode = node + blockCount - 1;
+	result.firstBlockIndex = splitIndex;
+	result.lastBlockIndex = lastBlockIndex;
+	result.sharesBlocks.store(sharesBlocks.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+	if (splitsBlock)
 	{
-		Block*& frontAddress = blockAddresses.front();
-		if (firstBlock != nullptr)  //if there is a first block,the first element of the deque is at the firstBlockIndex
+		std::size_t keptFirst = splitNode == firstNode ? firstBlockIndex : mInitialIndex;
+		std::size_t movedLast = splitNode == lastNode ? lastBlockIndex + 1 : mBlockSize;
+		if (splitIndex - keptFirst <= movedLast - splitIndex)
 		{
-			return frontAddress->data[firstBlockIndex];
+			relocateElements(*splitNode, newBlock, keptFirst, splitIndex);
+			*splitNode = newBlock;
 		}
-		else  //if there isn't a first block,there is only the lastBlock and the first element of the deque is at index 0 in that block
+		else
 		{
-			return frontAddress->data[0];
+			relocateElements(*splitNode, newBlock, splitIndex, movedLast);
+			*node = newBlock;
 		}
+		reservedEnd = std::copy(lastNode + 1, reservedEnd, splitNode + 1);
+		lastNode = splitNode;
+		lastBlockIndex = splitIndex - 1;
+	}
+	else
+	{
+		reservedEnd = std::copy(lastNode + 1, reservedEnd, splitNode);
+		lastNode = splitNode - 1;
+		lastBlockIndex = mLastValidIndex;
 	}
+	trimIdleBlocks();
+	return result;
 }
 
-template<typename T>
-T& Deque<T>::back()
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<typename InputIterator, typename>
+void Deque<T, BlockBytes, Allocator, Stats>::append(InputIterator first, InputIterator last)
 {
-	if (blockAddresses.empty())
+	using Category = typename std::iterator_traits<InputIterator>::iterator_category;
+	if constexpr (!std::is_base_of_v<std::forward_iterator_tag, Category>)  //a single pass range can't be measured before it is read,so it is buffered first
 	{
-		throw std::out_of_range("Deque is empty, cannot access back element.");
+		std::vector<T> buffer(first, last);
+		append(buffer.begin(), buffer.end());
 	}
 	else
 	{
-		Block*& backAddress = blockAddresses.back();
-		if (lastBlock != nullptr)  //if there is a lastBlock
+		std::size_t count = std::distance(first, last);
+		if (count == 0)
+			return;
+
+		if (firstNode == nullptr)  //an empty deque fills its idle blocks from the split on and allocates the rest behind them
+		{
+			std::size_t blockCount = blockNumber(count - 1) + 1;
+			std::size_t idleBlocks = reservedEnd - emptySplit();
+			std::size_t newBlocks = blockCount > idleBlocks ? blockCount - idleBlocks : 0;
+			reserveMapAtBack(newBlocks);
+			allocateBlocks(reservedEnd, reservedEnd + newBlocks);
+			Block** newFirstNode = emptySplit();
+			try
+			{
+				constructElements(newFirstNode, mInitialIndex, count, first);
+			}
+			catch (...)
+			{
+				deallocateBlocks(reservedEnd, reservedEnd + newBlocks);
+				throw;
+			}
+
+			reservedEnd += newBlocks;
+			firstNode = newFirstNode;
+			lastNode = newFirstNode + blockCount - 1;
+			firstBlockIndex = mInitialIndex;
+			lastBlockIndex = offsetInBlock(count - 1);
+			return;
+		}
+
+		//the positions are counted from the start of the last block.All the blocks are in place before the first element is copied and the deque is only updated at the end,so if a copy throws the deque is unchanged
+		if (lastBlockIndex != mLastValidIndex && sharesBlocks.load(std::memory_order_relaxed))
+			unshareBlock(lastNode);
+		std::size_t position = lastBlockIndex + 1;
+		std::size_t lastPosition = position + count - 1;
+		std::size_t blocksToAdd = blockNumber(lastPosition);
+		std::size_t idleBlocks = reservedEnd - lastNode - 1;
+		std::size_t newBlocks = blocksToAdd > idleBlocks ? blocksToAdd - idleBlocks : 0;
+		reserveMapAtBack(newBlocks);
+		allocateBlocks(reservedEnd, reservedEnd + newBlocks);
+		try
 		{
-			return backAddress->data[lastBlockIndex];
+			constructElements(lastNode, position, count, first);
 		}
-		else  //if there is not a lastBlock,there is only the firstBlock,and the last element of the deque is at index mLastValidIndex of that block
+		catch (...)
 		{
-			return backAddress->data[mLastValidIndex];
+			deallocateBlocks(reservedEnd, reservedEnd + newBlocks);
+			throw;
 		}
+
+		reservedEnd += newBlocks;
+		lastNode += blocksToAdd;
+		lastBlockIndex = offsetInBlock(lastPosition);
 	}
 }
 
-template<typename T>
-T& Deque<T>::operator[](int index)
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<typename InputIterator, typename>
+void Deque<T, BlockBytes, Allocator, Stats>::prepend(InputIterator first, InputIterator last)
 {
-	if (index < 0)
+	using Category = typename std::iterator_traits<InputIterator>::iterator_category;
+	if constexpr (!std::is_base_of_v<std::forward_iterator_tag, Category>)
 	{
-		clear();
-		throw std::out_of_range("Index out of range");
+		std::vector<T> buffer(first, last);
+		prepend(buffer.begin(), buffer.end());
 	}
-
-	int dequeSize = size();
-
-	if (index >= dequeSize)
+	else
 	{
-		if (dequeSize == 0)  //either the deque is empty
+		if (firstNode == nullptr)
 		{
-			throw std::out_of_range("Trying to access empty deque");
+			append(first, last);
+			return;
 		}
-		else  //or the index is out of range
+
+		std::size_t count = std::distance(first, last);
+		if (count == 0)
+			return;
+
+		//the range keeps its order,so it is copied forwards starting at the new first position
+		if (firstBlockIndex != mInitialIndex && sharesBlocks.load(std::memory_order_relaxed))
+			unshareBlock(firstNode);
+		std::size_t blocksToAdd = count > firstBlockIndex ? blockNumber(count - firstBlockIndex - 1) + 1 : 0;
+		std::size_t idleBlocks = firstNode - reservedBegin;
+		std::size_t newBlocks = blocksToAdd > idleBlocks ? blocksToAdd - idleBlocks : 0;
+		reserveMapAtFront(newBlocks);
+		Block** newFirstNode = firstNode - blocksToAdd;
+		std::size_t newFirstBlockIndex = blocksToAdd * mBlockSize + firstBlockIndex - count;
+		allocateBlocks(reservedBegin - newBlocks, reservedBegin);
+		try
 		{
-			clear();
-			throw std::out_of_range("Index out of range");
+			constructElements(newFirstNode, newFirstBlockIndex, count, first);
+		}
+		catch (...)
+		{
+			deallocateBlocks(reservedBegin - newBlocks, reservedBegin);
+			throw;
 		}
-	}
 
-	if (firstBlock == nullptr)  //if there is only one block and it is the lastBlock
-	{
-		return lastBlock->data[index];
+		reservedBegin -= newBlocks;
+		firstNode = newFirstNode;
+		firstBlockIndex = newFirstBlockIndex;
 	}
-	if (firstBlock != nullptr && lastBlock == nullptr)  //if there is only one block and it is the firstBlock
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<typename InputIterator, typename>
+void Deque<T, BlockBytes, Allocator, Stats>::assign(InputIterator first, InputIterator last)
+{
+	using Category = typename std::iterator_traits<InputIterator>::iterator_category;
+	if constexpr (!std::is_base_of_v<std::forward_iterator_tag, Category>)
 	{
-		return firstBlock->data[firstBlockIndex + index];
+		std::vector<T> buffer(first, last);
+		assign(buffer.begin(), buffer.end());
 	}
-	else  //if there are multiple blocks
+	else
 	{
-		if (index <= mLastValidIndex - firstBlockIndex)  //if the element trying to be accessed is in the first block
+		//the blocks the deque already has become idle and are filled again from the split on,so a deque that is reloaded with batches of the same size does not allocate.If a copy throws,the old elements are already gone and the deque is left empty
+		emptyBlocks();
+		try
 		{
-			return firstBlock->data[firstBlockIndex + index];
+			append(first, last);
 		}
-		else  //if the element trying to be accessed in in any block apart from the first block
+		catch (...)
 		{
-			int firstBlockElementsCount = mBlockSize - firstBlockIndex;
-			index -= firstBlockElementsCount;  //the element trying to be accessed is not in the first block so those elements are taken away from the index and the first block is ignored
-
-			int blockIndex = index / mBlockSize;
-			int elementIndex = index % mBlockSize;
-
-			Block* block = firstBlock->next;  //the first block is ignored because the element trying to be accessed is not from the firstBlock
-			for (int i = mInitialIndex; i < blockIndex; i++)
-				block = block->next;
-
-			return block->data[elementIndex];
+			trimIdleBlocks();
+			throw;
 		}
+		trimIdleBlocks();
 	}
 }
 
-template<typename T>
-bool Deque<T>::empty()
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+typename Deque<T, BlockBytes, Allocator, Stats>::Iterator Deque<T, BlockBytes, Allocator, Stats>::begin()
 {
-	return (firstBlock == nullptr && lastBlock == nullptr);
+	unshareBlocks();  //the elements can be written through the iterator,so the deque takes its own copy of the blocks it shares.Readers of a copy use the const iterators to keep sharing them
+
+	if (firstNode == nullptr)
+		return Iterator();
+
+	return Iterator(firstNode, firstBlockIndex);
 }
 
-template<typename T>
-void Deque<T>::clear()
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+typename Deque<T, BlockBytes, Allocator, Stats>::Iterator Deque<T, BlockBytes, Allocator, Stats>::end()
 {
-	for (auto pointer : blockAddresses)
-		delete pointer;
+	unshareBlocks();
+
+	if (lastNode == nullptr)
+		return Iterator();
 
-	blockAddresses.clear();
+	if (lastBlockIndex == mLastValidIndex)  //the position after a full last block is the start of the next directory slot,that slot is never dereferenced
+		return Iterator(lastNode + 1, mInitialIndex);
 
-	firstBlock = nullptr;
-	lastBlock = nullptr;
-	int firstBlockIndex = mBlockSize, lastBlockIndex = mInitialIndex - 1;
+	return Iterator(lastNode, lastBlockIndex + 1);
 }
 
-template<typename T>
-int Deque<T>::size()
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+typename Deque<T, BlockBytes, Allocator, Stats>::ConstIterator Deque<T, BlockBytes, Allocator, Stats>::begin() const
 {
-	if (empty())
-		return 0;
+	if (firstNode == nullptr)
+		return ConstIterator();
 
-	if (firstBlock != nullptr && lastBlock == nullptr)  //if there is only the firstBlock
-		return mBlockSize - firstBlockIndex;
+	return ConstIterator(firstNode, firstBlockIndex);
+}
 
-	if (lastBlock != nullptr && firstBlock == nullptr)  //if there is only the lastBlock
-		return lastBlockIndex + 1;
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+typename Deque<T, BlockBytes, Allocator, Stats>::ConstIterator Deque<T, BlockBytes, Allocator, Stats>::end() const
+{
+	if (lastNode == nullptr)
+		return ConstIterator();
 
-	int count = 0;
-	if (blockAddresses.size() >= 2)  //if there are at least a first block and a last block
-	{
-		for (int i = firstBlockIndex; i < mBlockSize; i++)
-			count++;
+	if (lastBlockIndex == mLastValidIndex)
+		return ConstIterator(lastNode + 1, mInitialIndex);
 
-		Block* pointer = blockAddresses.front();
-		pointer = pointer->next;
-		for (; pointer != blockAddresses.back(); pointer = pointer->next)
-			count += mBlockSize;
+	return ConstIterator(lastNode, lastBlockIndex + 1);
+}
 
-		for (int i = mInitialIndex; i <= lastBlockIndex; i++)
-			count++;
-	}
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+typename Deque<T, BlockBytes, Allocator, Stats>::ConstIterator Deque<T, BlockBytes, Allocator, Stats>::cbegin() const
+{
+	return begin();
+}
 
-	return count;
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+typename Deque<T, BlockBytes, Allocator, Stats>::ConstIterator Deque<T, BlockBytes, Allocator, Stats>::cend() const
+{
+	return end();
 }
 
-template<typename T>
-void Deque<T>::insert(const T& value, int index)
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+typename Deque<T, BlockBytes, Allocator, Stats>::reverse_iterator Deque<T, BlockBytes, Allocator, Stats>::rbegin()
 {
-	int dequeSize = size();
-	if (index < 0 || index > dequeSize)  //invalid index handling
-	{
-		clear();
-		throw std::out_of_range("Index out of range");
-	}
+	return reverse_iterator(end());
+}
 
-	if (index == mInitialIndex)  //if the value is inserted at index 0,then it is just push_front
-		push_front(value);
-	else if (index == dequeSize) //if the value is inserted after the last index,then it is just push_back
-		push_back(value);
-	else  //the value is inserted at the index and the elements after it are shifted one index to the right
-	{
-		T lastValue = (*this)[dequeSize - 1];  //the last element is saved and pushed_back.This way it is shifted to the right and also covers the case that a new block has to be made
-		for (int i = dequeSize - 1; i > index; i--)
-			(*this)[i] = (*this)[i - 1];
-		(*this)[index] = value;
-		push_back(lastValue);
-	}
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+typename Deque<T, BlockBytes, Allocator, Stats>::reverse_iterator Deque<T, BlockBytes, Allocator, Stats>::rend()
+{
+	return reverse_iterator(begin());
 }
 
-template<typename T>
-void Deque<T>::remove(int index)
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+typename Deque<T, BlockBytes, Allocator, Stats>::const_reverse_iterator Deque<T, BlockBytes, Allocator, Stats>::rbegin() const
 {
-	int dequeSize = size();
-	if (index < 0 || index >= dequeSize)  //invalid index handling
-	{
-		clear();
-		throw std::out_of_range("Index out of range");
-	}
+	return const_reverse_iterator(end());
+}
 
-	if (index == mInitialIndex)  //if the first element is removed
-		pop_front();
-	else if (index == dequeSize - 1)  //if the last element is removed
-		pop_back();
-	else
-	{
-		for (int i = index; i < dequeSize - 1; i++)  //shift all the elements one index to the left
-			(*this)[i] = (*this)[i + 1];
-		pop_back();  //remove the extra element
-	}
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+typename Deque<T, BlockBytes, Allocator, Stats>::const_reverse_iterator Deque<T, BlockBytes, Allocator, Stats>::rend() const
+{
+	return const_reverse_iterator(begin());
 }
 
-template<typename T>
-typename Deque<T>::Iterator Deque<T>::begin()
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+typename Deque<T, BlockBytes, Allocator, Stats>::const_reverse_iterator Deque<T, BlockBytes, Allocator, Stats>::crbegin() const
 {
-	Iterator it(*this);
-	if (firstBlock != nullptr)
-	{
-		it.block = firstBlock;
-		it.blockIndex = firstBlockIndex;
-		return it;
-	}
-	if (lastBlock != nullptr)
-	{
-		it.block = lastBlock;
-		it.blockIndex = mInitialIndex;
-	}
+	return rbegin();
+}
 
-	return it;
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+typename Deque<T, BlockBytes, Allocator, Stats>::const_reverse_iterator Deque<T, BlockBytes, Allocator, Stats>::crend() const
+{
+	return rend();
 }
 
-template<typename T>
-typename Deque<T>::Iterator Deque<T>::end()
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+typename Deque<T, BlockBytes, Allocator, Stats>::SegmentView Deque<T, BlockBytes, Allocator, Stats>::segments()
 {
-	Iterator it(*this);
-	if (lastBlock != nullptr)
-	{
-		it.block = lastBlock;
-		if (lastBlockIndex < mBlockSize)
-			it.blockIndex = lastBlockIndex + 1;
-		else
-			it.blockIndex = mBlockSize;
-		return it;
-	}
-	if (firstBlock != nullptr)
-	{
-		it.block = firstBlock;
-		it.blockIndex = mBlockSize;
-	}
+	unshareBlocks();
 
-	return it;
+	if (firstNode == nullptr)
+		return SegmentView({}, {});
+
+	return SegmentView({ firstNode, firstNode, lastNode, firstBlockIndex, lastBlockIndex }, { lastNode + 1, firstNode, lastNode, firstBlockIndex, lastBlockIndex });
 }
 
-template<typename T>
-T& Deque<T>::Iterator::operator*()
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+typename Deque<T, BlockBytes, Allocator, Stats>::ConstSegmentView Deque<T, BlockBytes, Allocator, Stats>::segments() const
 {
-	if (block == nullptr || blockIndex < mInitialIndex || blockIndex >= mBlockSize)
-		throw std::runtime_error("Invalid iterator dereference");
+	if (firstNode == nullptr)
+		return ConstSegmentView({}, {});
 
-	return block->data[blockIndex];
+	return ConstSegmentView({ firstNode, firstNode, lastNode, firstBlockIndex, lastBlockIndex }, { lastNode + 1, firstNode, lastNode, firstBlockIndex, lastBlockIndex });
 }
 
-template<typename T>
-T* Deque<T>::Iterator::operator->()
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+typename Deque<T, BlockBytes, Allocator, Stats>::template BasicSegmentIterator<IsConst>::value_type Deque<T, BlockBytes, Allocator, Stats>::BasicSegmentIterator<IsConst>::operator*() const
 {
-	if (block == nullptr || blockIndex < mInitialIndex || blockIndex >= mBlockSize)
-		throw std::runtime_error("Invalid iterator dereference");
-
-	return &(block->data[blockIndex]);
+	std::size_t segmentBegin = node == firstNode ? firstBlockIndex : mInitialIndex;  //only the first and the last block can be partly used
+	std::size_t segmentEnd = node == lastNode ? lastBlockIndex + 1 : mBlockSize;
+	return value_type((*node)->data() + segmentBegin, segmentEnd - segmentBegin);
 }
 
-template<typename T>
-typename Deque<T>::Iterator& Deque<T>::Iterator::operator=(const Iterator& other)
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+typename Deque<T, BlockBytes, Allocator, Stats>::template BasicSegmentIterator<IsConst>& Deque<T, BlockBytes, Allocator, Stats>::BasicSegmentIterator<IsConst>::operator++()
 {
-	block = other.block;
-	blockIndex = other.blockIndex;
-	this->dequeReference = other.dequeReference;
+	++node;
+	if constexpr (mPrefetchDistance > 0)
+		prefetchBlock(node[mPrefetchDistance]);
 
 	return *this;
 }
 
-template<typename T>
-bool Deque<T>::Iterator::operator==(const Iterator& other)
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+typename Deque<T, BlockBytes, Allocator, Stats>::template BasicSegmentIterator<IsConst> Deque<T, BlockBytes, Allocator, Stats>::BasicSegmentIterator<IsConst>::operator++(int)
+{
+	BasicSegmentIterator temp = *this;
+	++(*this);
+
+	return temp;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+bool Deque<T, BlockBytes, Allocator, Stats>::BasicSegmentIterator<IsConst>::operator==(const BasicSegmentIterator& other) const
 {
-	return(dequeReference.firstBlock == other.dequeReference.firstBlock && dequeReference.lastBlock == other.dequeReference.lastBlock && block == other.block && blockIndex == other.blockIndex);
+	return node == other.node;
 }
 
-template<typename T>
-bool Deque<T>::Iterator::operator!=(const Iterator& other)
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+bool Deque<T, BlockBytes, Allocator, Stats>::BasicSegmentIterator<IsConst>::operator!=(const BasicSegmentIterator& other) const
 {
-	return !(*this == other);
+	return node != other.node;
 }
 
-template<typename T>
-typename Deque<T>::Iterator& Deque<T>::Iterator::operator++()
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+typename Deque<T, BlockBytes, Allocator, Stats>::template BasicIterator<IsConst>::reference Deque<T, BlockBytes, Allocator, Stats>::BasicIterator<IsConst>::operator*() const
 {
-	if (block == nullptr)
-		throw std::runtime_error("Attempted to access nullptr");
+	return (*node)->data()[blockIndex];
+}
 
-	if (blockIndex < mLastValidIndex)
-	{
-		++blockIndex;
-		return *this;
-	}
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+typename Deque<T, BlockBytes, Allocator, Stats>::template BasicIterator<IsConst>::pointer Deque<T, BlockBytes, Allocator, Stats>::BasicIterator<IsConst>::operator->() const
+{
+	return (*node)->data() + blockIndex;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+typename Deque<T, BlockBytes, Allocator, Stats>::template BasicIterator<IsConst>::reference Deque<T, BlockBytes, Allocator, Stats>::BasicIterator<IsConst>::operator[](difference_type steps) const
+{
+	return *(*this + steps);
+}
 
-	if (block->next == nullptr || block == this->dequeReference.blockAddresses.back())
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+typename Deque<T, BlockBytes, Allocator, Stats>::template BasicIterator<IsConst>& Deque<T, BlockBytes, Allocator, Stats>::BasicIterator<IsConst>::operator++()
+{
+	if (++blockIndex == mBlockSize)
 	{
-		*this = dequeReference.end();
-		return *this;
+		blockIndex = mInitialIndex;
+		++node;
+		if constexpr (mPrefetchDistance > 0)
+			prefetchBlock(node[mPrefetchDistance]);
 	}
 
-	blockIndex = mInitialIndex;
-	block = block->next;
 	return *this;
 }
 
-template<typename T>
-typename Deque<T>::Iterator& Deque<T>::Iterator::operator--()
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+typename Deque<T, BlockBytes, Allocator, Stats>::template BasicIterator<IsConst>& Deque<T, BlockBytes, Allocator, Stats>::BasicIterator<IsConst>::operator--()
 {
-	if (block == nullptr)
-		throw std::runtime_error("Attempted to access nullptr");
-
-	if (block == dequeReference.firstBlock)
+	if (blockIndex == mInitialIndex)
 	{
-		if (blockIndex <= dequeReference.firstBlockIndex)
-		{
-			*this = dequeReference.begin();
-			return *this;
-		}
-
-		--blockIndex;
-		return *this;
+		blockIndex = mBlockSize;
+		--node;
 	}
-	if (blockIndex <= mInitialIndex)
-	{
-		block = block->previous;
-		blockIndex = mLastValidIndex;
-		return *this;
-	}
-
 	--blockIndex;
+
 	return *this;
 }
 
-template<typename T>
-typename Deque<T>::Iterator Deque<T>::Iterator::operator++(int)
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+typename Deque<T, BlockBytes, Allocator, Stats>::template BasicIterator<IsConst> Deque<T, BlockBytes, Allocator, Stats>::BasicIterator<IsConst>::operator++(int)
 {
-	Iterator temp = *this;
+	BasicIterator temp = *this;
 	++(*this);
 
 	return temp;
 }
 
-template<typename T>
-typename Deque<T>::Iterator Deque<T>::Iterator::operator--(int)
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+typename Deque<T, BlockBytes, Allocator, Stats>::template BasicIterator<IsConst> Deque<T, BlockBytes, Allocator, Stats>::BasicIterator<IsConst>::operator--(int)
 {
-	Iterator temp = *this;
+	BasicIterator temp = *this;
 	--(*this);
 
 	return temp;
 }
 
-template<typename T>
-typename Deque<T>::Iterator Deque<T>::Iterator::operator+(int stepsForward)
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+typename Deque<T, BlockBytes, Allocator, Stats>::template BasicIterator<IsConst>& Deque<T, BlockBytes, Allocator, Stats>::BasicIterator<IsConst>::operator+=(difference_type steps)
+{
+	difference_type position = static_cast<difference_type>(blockIndex) + steps;
+	if (position >= 0 && position < static_cast<difference_type>(mBlockSize))  //the new position is in the same block
+	{
+		blockIndex = static_cast<std::size_t>(position);
+	}
+	else if (position >= 0)
+	{
+		node += blockNumber(static_cast<std::size_t>(position));
+		blockIndex = offsetInBlock(static_cast<std::size_t>(position));
+	}
+	else  //going backwards past the start of the block,the distance is counted from the end of the previous block
+	{
+		std::size_t distanceBack = static_cast<std::size_t>(-position) - 1;
+		node -= blockNumber(distanceBack) + 1;
+		blockIndex = mLastValidIndex - offsetInBlock(distanceBack);
+	}
+
+	return *this;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+typename Deque<T, BlockBytes, Allocator, Stats>::template BasicIterator<IsConst>& Deque<T, BlockBytes, Allocator, Stats>::BasicIterator<IsConst>::operator-=(difference_type steps)
 {
-	Iterator it = *this;
-	for (int i = 0; i < stepsForward; ++i)
-		++it;
+	return *this += -steps;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+typename Deque<T, BlockBytes, Allocator, Stats>::template BasicIterator<IsConst> Deque<T, BlockBytes, Allocator, Stats>::BasicIterator<IsConst>::operator+(difference_type steps) const
+{
+	BasicIterator it = *this;
+	it += steps;
 
 	return it;
 }
 
-template<typename T>
-typename Deque<T>::Iterator Deque<T>::Iterator::operator-(int stepsBackwards)
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+typename Deque<T, BlockBytes, Allocator, Stats>::template BasicIterator<IsConst> Deque<T, BlockBytes, Allocator, Stats>::BasicIterator<IsConst>::operator-(difference_type steps) const
 {
-	Iterator it = *this;
-	for (int i = 0; i < stepsBackwards; i++)
-		--it;
+	BasicIterator it = *this;
+	it -= steps;
 
 	return it;
 }
 
-template<typename T>
-typename Deque<T>::Iterator& Deque<T>::Iterator::operator+=(int steps)
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+template<bool OtherIsConst>
+typename Deque<T, BlockBytes, Allocator, Stats>::template BasicIterator<IsConst>::difference_type Deque<T, BlockBytes, Allocator, Stats>::BasicIterator<IsConst>::operator-(const BasicIterator<OtherIsConst>& other) const
 {
-	while (steps > 0)
-	{
-		++(*this);
-		--steps;
-	}
-	while (steps < 0)  //if steps value is negative,it goes backwards
-	{
-		--(*this);
-		++steps;
-	}
+	return (node - other.node) * static_cast<difference_type>(mBlockSize) + static_cast<difference_type>(blockIndex) - static_cast<difference_type>(other.blockIndex);
+}
 
-	return *this;
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+template<bool OtherIsConst>
+bool Deque<T, BlockBytes, Allocator, Stats>::BasicIterator<IsConst>::operator==(const BasicIterator<OtherIsConst>& other) const
+{
+	return node == other.node && blockIndex == other.blockIndex;
 }
 
-template<typename T>
-typename Deque<T>::Iterator& Deque<T>::Iterator::operator-=(int steps)
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+template<bool OtherIsConst>
+bool Deque<T, BlockBytes, Allocator, Stats>::BasicIterator<IsConst>::operator!=(const BasicIterator<OtherIsConst>& other) const
 {
-	while (steps > 0)
-	{
-		--(*this);
-		--steps;
-	}
-	while (steps < 0)
-	{
-		++(*this);
-		++steps;
-	}
+	return !(*this == other);
+}
 
-	return *this;
-}
\ No newline at end of file
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+template<bool OtherIsConst>
+bool Deque<T, BlockBytes, Allocator, Stats>::BasicIterator<IsConst>::operator<(const BasicIterator<OtherIsConst>& other) const
+{
+	return node < other.node || (node == other.node && blockIndex < other.blockIndex);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+template<bool OtherIsConst>
+bool Deque<T, BlockBytes, Allocator, Stats>::BasicIterator<IsConst>::operator>(const BasicIterator<OtherIsConst>& other) const
+{
+	return other < *this;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+template<bool OtherIsConst>
+bool Deque<T, BlockBytes, Allocator, Stats>::BasicIterator<IsConst>::operator<=(const BasicIterator<OtherIsConst>& other) const
+{
+	return !(other < *this);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator, typename Stats>
+template<bool IsConst>
+template<bool OtherIsConst>
+bool Deque<T, BlockBytes, Allocator, Stats>::BasicIterator<IsConst>::operator>=(const BasicIterator<OtherIsConst>& other) const
+{
+	return !(*this < other);
+}
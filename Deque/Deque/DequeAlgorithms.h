@@ -0,0 +1,65 @@
+#pragma once
+#include"Deque.h"
+#include<algorithm>
+#include<cstddef>
+#include<utility>
+
+//versions of a few standard algorithms that walk a deque one segment at a time.The inner loops run over contiguous memory,so they don't pay for the block checks of the deque iterator and the compiler can vectorize them
+
+//calls function on every element from the front of the deque to the back and returns the function like std::for_each
+template<typename DequeType, typename Function>
+Function segmented_for_each(DequeType& deque, Function function)
+{
+	for (auto segment : deque.segments())
+		for (auto& element : segment)
+			function(element);
+
+	return function;
+}
+
+//returns an iterator to the first element equal to value,or end() if there is no such element
+template<typename DequeType, typename Value>
+auto segmented_find(DequeType& deque, const Value& value) -> decltype(deque.begin())
+{
+	std::size_t index = 0;
+	for (auto segment : deque.segments())
+	{
+		auto found = std::find(segment.begin(), segment.end(), value);
+		if (found != segment.end())
+			return deque.begin() + (index + (found - segment.begin()));
+		index += segment.size();
+	}
+
+	return deque.end();
+}
+
+//copies the elements to output in order and returns the output iterator past the last copied element
+template<typename DequeType, typename OutputIterator>
+OutputIterator segmented_copy(const DequeType& deque, OutputIterator output)
+{
+	for (auto segment : deque.segments())
+		output = std::copy(segment.begin(), segment.end(), output);
+
+	return output;
+}
+
+//folds the elements from the front to the back into init,with + or with the given operation
+template<typename DequeType, typename Value>
+Value segmented_accumulate(const DequeType& deque, Value init)
+{
+	for (auto segment : deque.segments())
+		for (const auto& element : segment)
+			init = std::move(init) + element;
+
+	return init;
+}
+
+template<typename DequeType, typename Value, typename BinaryOperation>
+Value segmented_accumulate(const DequeType& deque, Value init, BinaryOperation operation)
+{
+	for (auto segment : deque.segments())
+		for (const auto& element : segment)
+			init = operation(std::move(init), element);
+
+	return init;
+}
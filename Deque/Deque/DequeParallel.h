@@ -0,0 +1,393 @@
+#pragma once
+#include"Deque.h"
+#include<algorithm>
+#include<atomic>
+#include<condition_variable>
+#include<cstddef>
+#include<cstdint>
+#include<exception>
+#include<functional>
+#include<iterator>
+#include<mutex>
+#include<optional>
+#include<thread>
+#include<type_traits>
+#include<utility>
+#include<vector>
+#if __has_include(<execution>)
+#include<execution>
+#endif
+
+//parallel versions of for_each,transform,reduce,count_if and sort for a deque.The deque is split between the threads on block boundaries,so no two threads write to the same block or fight over its cache lines.
+//the first argument is a DequeThreadPool or a standard execution policy:std::execution::seq runs on the calling thread,the parallel policies run on DequeThreadPool::shared().With libstdc++ <execution> needs TBB to link when its headers are installed,the CMake build links it when it finds it
+
+//a fixed set of worker threads that run the tasks of one job at a time.The thread that calls run takes tasks as well,so a pool of n threads starts n - 1 workers
+class DequeThreadPool
+{
+	std::vector<std::thread> workers;
+	std::mutex runMutex;  //run is called by one thread at a time
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable finished;
+	const std::function<void(std::size_t)>* job;
+	std::size_t taskCount;
+	std::atomic<std::size_t> nextTask;
+	std::size_t busyWorkers;  //the workers that haven't finished the current job
+	std::uint64_t generation;  //counts the jobs,a worker waits until it changes
+	std::exception_ptr error;
+	bool stopping;
+
+	void work();
+
+	void runTasks();
+
+public:
+	explicit DequeThreadPool(std::size_t threadCount = std::thread::hardware_concurrency());
+
+	DequeThreadPool(const DequeThreadPool&) = delete;
+	DequeThreadPool& operator=(const DequeThreadPool&) = delete;
+
+	~DequeThreadPool();
+
+	//the number of threads that run tasks,including the calling thread
+	std::size_t thread_count() const;
+
+	//calls function(task) for every task in [0, taskCount) and returns when all of them are done.If a task throws,the tasks that haven't started are skipped and the first exception is rethrown.A task must not call run on the same pool
+	template<typename Function>
+	void run(std::size_t taskCount, Function function);
+
+	//the pool the parallel execution policies run on,with one thread per hardware thread
+	static DequeThreadPool& shared();
+};
+
+#if defined(__cpp_lib_execution)
+template<typename Executor>
+concept DequeExecutor = std::is_same_v<std::remove_cvref_t<Executor>, DequeThreadPool> || std::is_execution_policy_v<std::remove_cvref_t<Executor>>;
+#else
+template<typename Executor>
+concept DequeExecutor = std::is_same_v<std::remove_cvref_t<Executor>, DequeThreadPool>;
+#endif
+
+//calls function on every element.It is called from several threads at once,and never for two elements of the same block at the same time
+template<DequeExecutor Executor, typename DequeType, typename Function>
+void parallel_for_each(Executor&& executor, DequeType& deque, Function function);
+
+//replaces every element with operation(element)
+template<DequeExecutor Executor, typename DequeType, typename UnaryOperation>
+void parallel_transform(Executor&& executor, DequeType& deque, UnaryOperation operation);
+
+//writes operation(element) to output for every element in order and returns the output iterator past the last written element.The work is split on the blocks of the deque,so an output deque with other block boundaries can have two threads writing to different elements of one of its blocks
+template<DequeExecutor Executor, typename DequeType, std::random_access_iterator OutputIterator, typename UnaryOperation>
+OutputIterator parallel_transform(Executor&& executor, const DequeType& deque, OutputIterator output, UnaryOperation operation);
+
+//folds the elements into init with operation,which must be associative and commutative like for std::reduce,because the blocks are folded on different threads and the partial results are combined afterwards
+template<DequeExecutor Executor, typename DequeType, typename Value, typename BinaryOperation>
+Value parallel_reduce(Executor&& executor, const DequeType& deque, Value init, BinaryOperation operation);
+
+template<DequeExecutor Executor, typename DequeType, typename Value>
+Value parallel_reduce(Executor&& executor, const DequeType& deque, Value init);
+
+//the number of elements for which predicate returns true
+template<DequeExecutor Executor, typename DequeType, typename Predicate>
+std::size_t parallel_count_if(Executor&& executor, const DequeType& deque, Predicate predicate);
+
+//sorts the deque.Every thread sorts a part made of whole blocks,then neighbouring parts are merged in place in rounds,the merges of a round run in parallel.The last round is one merge of the whole deque,so the sort scales less than the other algorithms
+template<DequeExecutor Executor, typename DequeType, typename Compare = std::less<>>
+void parallel_sort(Executor&& executor, DequeType& deque, Compare compare = Compare());
+
+inline DequeThreadPool::DequeThreadPool(std::size_t threadCount) : job(nullptr), taskCount(0), nextTask(0), busyWorkers(0), generation(0), stopping(false)
+{
+	for (std::size_t i = 1; i < threadCount; i++)  //a threadCount of 0,when the hardware concurrency is unknown,runs everything on the calling thread
+		workers.emplace_back(&DequeThreadPool::work, this);
+}
+
+inline DequeThreadPool::~DequeThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread& worker : workers)
+		worker.join();
+}
+
+inline std::size_t DequeThreadPool::thread_count() const
+{
+	return workers.size() + 1;
+}
+
+inline DequeThreadPool& DequeThreadPool::shared()
+{
+	static DequeThreadPool pool;
+	return pool;
+}
+
+inline void DequeThreadPool::work()
+{
+	std::uint64_t seenGeneration = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [&]() { return stopping || generation != seenGeneration; });
+			if (stopping)
+				return;
+			seenGeneration = generation;
+		}
+
+		runTasks();
+
+		std::lock_guard<std::mutex> lock(mutex);
+		if (--busyWorkers == 0)
+			finished.notify_one();
+	}
+}
+
+inline void DequeThreadPool::runTasks()
+{
+	//the job and the task count were written before the generation changed,under the mutex every thread locked since
+	for (std::size_t task = nextTask.fetch_add(1, std::memory_order_relaxed); task < taskCount; task = nextTask.fetch_add(1, std::memory_order_relaxed))
+	{
+		try
+		{
+			(*job)(task);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (error == nullptr)
+				error = std::current_exception();
+			nextTask.store(taskCount, std::memory_order_relaxed);
+		}
+	}
+}
+
+template<typename Function>
+void DequeThreadPool::run(std::size_t count, Function function)
+{
+	if (count == 0)
+		return;
+
+	std::function<void(std::size_t)> task(std::ref(function));
+	std::lock_guard<std::mutex> runLock(runMutex);
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		job = &task;
+		taskCount = count;
+		nextTask.store(0, std::memory_order_relaxed);
+		busyWorkers = workers.size();
+		generation++;
+	}
+	wake.notify_all();
+
+	runTasks();
+
+	std::unique_lock<std::mutex> lock(mutex);
+	finished.wait(lock, [&]() { return busyWorkers == 0; });  //every worker has to be done before the job goes out of scope
+	job = nullptr;
+	if (error != nullptr)
+		std::rethrow_exception(std::exchange(error, nullptr));
+}
+
+//the pool an executor runs on,nullptr for the sequential policies
+template<typename Executor>
+DequeThreadPool* dequeThreadPool(Executor& executor)
+{
+	using ExecutorType = std::remove_cvref_t<Executor>;
+	if constexpr (std::is_same_v<ExecutorType, DequeThreadPool>)
+		return &executor;
+#if defined(__cpp_lib_execution)
+	else if constexpr (std::is_same_v<ExecutorType, std::execution::sequenced_policy>)
+		return nullptr;
+#if __cpp_lib_execution >= 201902L
+	else if constexpr (std::is_same_v<ExecutorType, std::execution::unsequenced_policy>)
+		return nullptr;
+#endif
+	else
+		return &DequeThreadPool::shared();
+#endif
+}
+
+//the segments of a deque split into parts of whole segments with about the same number of elements.Part i is the segments [partBegin[i], partBegin[i + 1]) and its first element is element partOffset[i] of the deque
+template<typename Segment>
+struct DequePartition
+{
+	std::vector<Segment> segments;
+	std::vector<std::size_t> partBegin;
+	std::vector<std::size_t> partOffset;
+
+	std::size_t partCount() const { return partBegin.size() - 1; }
+};
+
+template<typename DequeType>
+auto dequePartition(DequeType& deque, std::size_t maxParts)
+{
+	using Segment = typename decltype(deque.segments().begin())::value_type;
+	DequePartition<Segment> partition;
+	std::size_t elementCount = 0;
+	for (Segment segment : deque.segments())
+	{
+		partition.segments.push_back(segment);
+		elementCount += segment.size();
+	}
+
+	//a part ends at the first segment boundary at or after its share of the elements,so no part is empty
+	std::size_t partCount = std::max<std::size_t>(1, std::min(maxParts, partition.segments.size()));
+	std::size_t offset = 0;
+	partition.partBegin.push_back(0);
+	partition.partOffset.push_back(0);
+	for (std::size_t i = 0; i < partition.segments.size(); i++)
+	{
+		offset += partition.segments[i].size();
+		std::size_t part = partition.partBegin.size();
+		if (part < partCount && offset >= elementCount * part / partCount && i + 1 < partition.segments.size())
+		{
+			partition.partBegin.push_back(i + 1);
+			partition.partOffset.push_back(offset);
+		}
+	}
+	partition.partBegin.push_back(partition.segments.size());
+	partition.partOffset.push_back(elementCount);
+	return partition;
+}
+
+//how many parts the deque is split into.A pool gets a few parts per thread,so a thread that finishes early takes another one
+template<typename Executor>
+std::size_t dequePartCount(Executor& executor, std::size_t partsPerThread)
+{
+	DequeThreadPool* pool = dequeThreadPool(executor);
+	return pool != nullptr ? pool->thread_count() * partsPerThread : 1;
+}
+
+//calls function(part) for every part,on the calling thread for the sequential policies
+template<typename Executor, typename Function>
+void dequeRunParts(Executor& executor, std::size_t partCount, Function function)
+{
+	DequeThreadPool* pool = dequeThreadPool(executor);
+	if (pool == nullptr || partCount == 1)
+	{
+		for (std::size_t part = 0; part < partCount; part++)
+			function(part);
+		return;
+	}
+
+	pool->run(partCount, function);
+}
+
+template<DequeExecutor Executor, typename DequeType, typename Function>
+void parallel_for_each(Executor&& executor, DequeType& deque, Function function)
+{
+	auto partition = dequePartition(deque, dequePartCount(executor, 4));
+	dequeRunParts(executor, partition.partCount(), [&](std::size_t part)
+	{
+		for (std::size_t i = partition.partBegin[part]; i < partition.partBegin[part + 1]; i++)
+			for (auto& element : partition.segments[i])
+				function(element);
+	});
+}
+
+template<DequeExecutor Executor, typename DequeType, typename UnaryOperation>
+void parallel_transform(Executor&& executor, DequeType& deque, UnaryOperation operation)
+{
+	auto partition = dequePartition(deque, dequePartCount(executor, 4));
+	dequeRunParts(executor, partition.partCount(), [&](std::size_t part)
+	{
+		for (std::size_t i = partition.partBegin[part]; i < partition.partBegin[part + 1]; i++)
+			for (auto& element : partition.segments[i])
+				element = operation(element);
+	});
+}
+
+template<DequeExecutor Executor, typename DequeType, std::random_access_iterator OutputIterator, typename UnaryOperation>
+OutputIterator parallel_transform(Executor&& executor, const DequeType& deque, OutputIterator output, UnaryOperation operation)
+{
+	using Difference = std::iter_difference_t<OutputIterator>;
+	auto partition = dequePartition(deque, dequePartCount(executor, 4));
+	dequeRunParts(executor, partition.partCount(), [&](std::size_t part)
+	{
+		OutputIterator target = output + static_cast<Difference>(partition.partOffset[part]);
+		for (std::size_t i = partition.partBegin[part]; i < partition.partBegin[part + 1]; i++)
+			target = std::transform(partition.segments[i].begin(), partition.segments[i].end(), target, operation);
+	});
+	return output + static_cast<Difference>(partition.partOffset.back());
+}
+
+template<DequeExecutor Executor, typename DequeType, typename Value, typename BinaryOperation>
+Value parallel_reduce(Executor&& executor, const DequeType& deque, Value init, BinaryOperation operation)
+{
+	//every part folds its own elements starting from its first one,so the operation doesn't need an identity element
+	auto partition = dequePartition(deque, dequePartCount(executor, 4));
+	std::vector<std::optional<Value>> partials(partition.partCount());
+	dequeRunParts(executor, partition.partCount(), [&](std::size_t part)
+	{
+		std::optional<Value> partial;
+		for (std::size_t i = partition.partBegin[part]; i < partition.partBegin[part + 1]; i++)
+		{
+			for (const auto& element : partition.segments[i])
+			{
+				if (partial.has_value())
+					partial = operation(std::move(*partial), element);
+				else
+					partial.emplace(element);
+			}
+		}
+		partials[part] = std::move(partial);
+	});
+
+	for (std::optional<Value>& partial : partials)
+	{
+		if (partial.has_value())
+			init = operation(std::move(init), std::move(*partial));
+	}
+	return init;
+}
+
+template<DequeExecutor Executor, typename DequeType, typename Value>
+Value parallel_reduce(Executor&& executor, const DequeType& deque, Value init)
+{
+	return parallel_reduce(executor, deque, std::move(init), std::plus<>());
+}
+
+template<DequeExecutor Executor, typename DequeType, typename Predicate>
+std::size_t parallel_count_if(Executor&& executor, const DequeType& deque, Predicate predicate)
+{
+	auto partition = dequePartition(deque, dequePartCount(executor, 4));
+	std::vector<std::size_t> counts(partition.partCount());
+	dequeRunParts(executor, partition.partCount(), [&](std::size_t part)
+	{
+		std::size_t count = 0;
+		for (std::size_t i = partition.partBegin[part]; i < partition.partBegin[part + 1]; i++)
+			count += std::count_if(partition.segments[i].begin(), partition.segments[i].end(), predicate);
+		counts[part] = count;
+	});
+
+	std::size_t total = 0;
+	for (std::size_t count : counts)
+		total += count;
+	return total;
+}
+
+template<DequeExecutor Executor, typename DequeType, typename Compare>
+void parallel_sort(Executor&& executor, DequeType& deque, Compare compare)
+{
+	auto partition = dequePartition(deque, dequePartCount(executor, 1));  //segments() takes copies of the blocks this deque shares before the iterators are made
+	std::size_t partCount = partition.partCount();
+	const std::vector<std::size_t>& offsets = partition.partOffset;
+	auto first = deque.begin();
+	dequeRunParts(executor, partCount, [&](std::size_t part) { std::sort(first + offsets[part], first + offsets[part + 1], compare); });
+
+	//the runs [offsets[i], offsets[i + width]) are sorted,every round merges pairs of neighbouring runs
+	for (std::size_t width = 1; width < partCount; width *= 2)
+	{
+		std::size_t mergeCount = (partCount + 2 * width - 1) / (2 * width);
+		dequeRunParts(executor, mergeCount, [&](std::size_t merge)
+		{
+			std::size_t begin = merge * 2 * width;
+			std::size_t middle = std::min(begin + width, partCount);
+			std::size_t end = std::min(begin + 2 * width, partCount);
+			if (middle < end)
+				std::inplace_merge(first + offsets[begin], first + offsets[middle], first + offsets[end], compare);
+		});
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include<algorithm>
+#include<concepts>
+#include<cstddef>
+#include<cstdint>
+#include<istream>
+#include<ostream>
+#include<stdexcept>
+#include<string>
+
+//the header Deque::save writes in front of the elements.The fields are written in the byte order of the machine,so a checkpoint is meant to be loaded on the same kind of machine that saved it
+struct DequeStreamHeader
+{
+	static constexpr std::uint32_t mMagic = 0x51454431;  //"1DEQ" in little endian
+	static constexpr std::uint16_t mVersion = 1;
+	static constexpr std::uint16_t mRawFormat = 0;  //the elements follow as raw bytes,one block range after the other
+	static constexpr std::uint16_t mSerializerFormat = 1;  //every element was written by DequeSerializer<T>::write
+
+	std::uint32_t magic;
+	std::uint16_t version;
+	std::uint16_t format;
+	std::uint64_t elementSize;
+	std::uint64_t count;
+};
+
+static_assert(sizeof(DequeStreamHeader) == 24, "DequeStreamHeader must not have padding");
+
+//the customization point of Deque::save and Deque::load.Trivially copyable elements are saved as raw bytes and need nothing here,any other element type needs a specialization with
+//static void write(std::ostream& stream, const T& value) and static T read(std::istream& stream)
+template<typename T>
+struct DequeSerializer {};
+
+template<typename T>
+concept DequeSerializable = requires(std::ostream& output, std::istream& input, const T& value)
+{
+	DequeSerializer<T>::write(output, value);
+	{ DequeSerializer<T>::read(input) } -> std::convertible_to<T>;
+};
+
+//a string is saved as its length followed by its characters
+template<typename CharT, typename Traits, typename Allocator>
+struct DequeSerializer<std::basic_string<CharT, Traits, Allocator>>
+{
+	using String = std::basic_string<CharT, Traits, Allocator>;
+
+	static constexpr std::size_t mReadChunk = 65536;
+
+	static void write(std::ostream& stream, const String& value)
+	{
+		std::uint64_t length = value.size();
+		stream.write(reinterpret_cast<const char*>(&length), sizeof(length));
+		stream.write(reinterpret_cast<const char*>(value.data()), static_cast<std::streamsize>(length * sizeof(CharT)));
+	}
+
+	static String read(std::istream& stream)
+	{
+		std::uint64_t length = 0;
+		if (!stream.read(reinterpret_cast<char*>(&length), sizeof(length)))
+			throw std::runtime_error("Deque stream is truncated");
+
+		//the characters are read in chunks,so a corrupted length fails with a truncated stream instead of allocating the whole length up front
+		String value;
+		while (value.size() < length)
+		{
+			std::size_t offset = value.size();
+			std::size_t chunk = static_cast<std::size_t>(std::min<std::uint64_t>(length - offset, mReadChunk));
+			value.resize(offset + chunk);
+			if (!stream.read(reinterpret_cast<char*>(value.data() + offset), static_cast<std::streamsize>(chunk * sizeof(CharT))))
+				throw std::runtime_error("Deque stream is truncated");
+		}
+		return value;
+	}
+};
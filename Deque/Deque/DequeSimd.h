@@ -0,0 +1,503 @@
+#pragma once
+#include"Deque.h"
+#include<bit>
+#include<cstddef>
+#include<cstdint>
+#include<stdexcept>
+#include<type_traits>
+
+//vectorized search and reduction kernels for Deque<std::int32_t>,Deque<float> and Deque<double>.The instruction set is chosen when the header is compiled:AVX2 when the compiler targets it (-mavx2,/arch:AVX2),otherwise SSE2 on x86-64,otherwise the scalar loops.
+//The kernels run over the segments of the deque,so every block is one contiguous inner loop and a bigger BlockBytes gives longer vector loops with fewer scalar tails
+#if defined(__AVX2__)
+#include<immintrin.h>
+#define DEQUE_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include<emmintrin.h>
+#define DEQUE_SIMD_SSE2
+#endif
+
+enum class SimdCompare
+{
+	Equal,
+	NotEqual,
+	Less,
+	Greater
+};
+
+//integers are summed in 64 bits so a long queue doesn't overflow,floating point values in their own type
+template<typename T>
+using SimdSumType = std::conditional_t<std::is_integral_v<T>, std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>, T>;
+
+template<SimdCompare Compare, typename T>
+bool simdCompareScalar(const T& element, const T& value)
+{
+	if constexpr (Compare == SimdCompare::Equal)
+		return element == value;
+	else if constexpr (Compare == SimdCompare::NotEqual)
+		return element != value;
+	else if constexpr (Compare == SimdCompare::Less)
+		return element < value;
+	else
+		return value < element;
+}
+
+//the lane masks have at most 8 bits,a nibble table counts them without needing the popcnt instruction
+inline unsigned simdCountLanes(unsigned mask)
+{
+	static constexpr unsigned char bitCounts[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+	return bitCounts[mask & 0xFu] + bitCounts[mask >> 4];
+}
+
+//the vector operations the kernels need for one element type.Types without a specialization use the scalar loops
+template<typename T>
+struct SimdVector
+{
+	static constexpr bool mEnabled = false;
+};
+
+#if defined(DEQUE_SIMD_AVX2)
+
+template<>
+struct SimdVector<std::int32_t>
+{
+	static constexpr bool mEnabled = true;
+	static constexpr std::size_t mWidth = 8;
+	using Register = __m256i;
+	using SumRegister = __m256i;  //four 64 bit lanes
+
+	static Register load(const std::int32_t* source) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source)); }
+	static Register broadcast(std::int32_t value) { return _mm256_set1_epi32(value); }
+	static void store(std::int32_t* target, Register value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(target), value); }
+	static Register minimum(Register a, Register b) { return _mm256_min_epi32(a, b); }
+	static Register maximum(Register a, Register b) { return _mm256_max_epi32(a, b); }
+
+	template<SimdCompare Compare>
+	static unsigned compare(Register elements, Register value)
+	{
+		__m256i mask;
+		if constexpr (Compare == SimdCompare::Equal || Compare == SimdCompare::NotEqual)
+			mask = _mm256_cmpeq_epi32(elements, value);
+		else if constexpr (Compare == SimdCompare::Less)
+			mask = _mm256_cmpgt_epi32(value, elements);
+		else
+			mask = _mm256_cmpgt_epi32(elements, value);
+
+		unsigned bits = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+		return Compare == SimdCompare::NotEqual ? ~bits & 0xFFu : bits;
+	}
+
+	static SumRegister zeroSum() { return _mm256_setzero_si256(); }
+
+	static SumRegister addToSum(SumRegister sum, Register elements)
+	{
+		sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(elements)));
+		return _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(elements, 1)));
+	}
+
+	static std::int64_t reduceSum(SumRegister sum)
+	{
+		alignas(32) std::int64_t lanes[4];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum);
+		return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+	}
+};
+
+template<>
+struct SimdVector<float>
+{
+	static constexpr bool mEnabled = true;
+	static constexpr std::size_t mWidth = 8;
+	using Register = __m256;
+	using SumRegister = __m256;
+
+	static Register load(const float* source) { return _mm256_loadu_ps(source); }
+	static Register broadcast(float value) { return _mm256_set1_ps(value); }
+	static void store(float* target, Register value) { _mm256_storeu_ps(target, value); }
+	static Register minimum(Register a, Register b) { return _mm256_min_ps(a, b); }
+	static Register maximum(Register a, Register b) { return _mm256_max_ps(a, b); }
+
+	template<SimdCompare Compare>
+	static unsigned compare(Register elements, Register value)
+	{
+		if constexpr (Compare == SimdCompare::Equal)
+			return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(elements, value, _CMP_EQ_OQ)));
+		else if constexpr (Compare == SimdCompare::NotEqual)
+			return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(elements, value, _CMP_NEQ_UQ)));
+		else if constexpr (Compare == SimdCompare::Less)
+			return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(elements, value, _CMP_LT_OQ)));
+		else
+			return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(elements, value, _CMP_GT_OQ)));
+	}
+
+	static SumRegister zeroSum() { return _mm256_setzero_ps(); }
+	static SumRegister addToSum(SumRegister sum, Register elements) { return _mm256_add_ps(sum, elements); }
+
+	static float reduceSum(SumRegister sum)
+	{
+		alignas(32) float lanes[8];
+		_mm256_store_ps(lanes, sum);
+		return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+	}
+};
+
+template<>
+struct SimdVector<double>
+{
+	static constexpr bool mEnabled = true;
+	static constexpr std::size_t mWidth = 4;
+	using Register = __m256d;
+	using SumRegister = __m256d;
+
+	static Register load(const double* source) { return _mm256_loadu_pd(source); }
+	static Register broadcast(double value) { return _mm256_set1_pd(value); }
+	static void store(double* target, Register value) { _mm256_storeu_pd(target, value); }
+	static Register minimum(Register a, Register b) { return _mm256_min_pd(a, b); }
+	static Register maximum(Register a, Register b) { return _mm256_max_pd(a, b); }
+
+	template<SimdCompare Compare>
+	static unsigned compare(Register elements, Register value)
+	{
+		if constexpr (Compare == SimdCompare::Equal)
+			return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(elements, value, _CMP_EQ_OQ)));
+		else if constexpr (Compare == SimdCompare::NotEqual)
+			return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(elements, value, _CMP_NEQ_UQ)));
+		else if constexpr (Compare == SimdCompare::Less)
+			return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(elements, value, _CMP_LT_OQ)));
+		else
+			return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(elements, value, _CMP_GT_OQ)));
+	}
+
+	static SumRegister zeroSum() { return _mm256_setzero_pd(); }
+	static SumRegister addToSum(SumRegister sum, Register elements) { return _mm256_add_pd(sum, elements); }
+
+	static double reduceSum(SumRegister sum)
+	{
+		alignas(32) double lanes[4];
+		_mm256_store_pd(lanes, sum);
+		return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+	}
+};
+
+#elif defined(DEQUE_SIMD_SSE2)
+
+template<>
+struct SimdVector<std::int32_t>
+{
+	static constexpr bool mEnabled = true;
+	static constexpr std::size_t mWidth = 4;
+	using Register = __m128i;
+	using SumRegister = __m128i;  //two 64 bit lanes
+
+	static Register load(const std::int32_t* source) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(source)); }
+	static Register broadcast(std::int32_t value) { return _mm_set1_epi32(value); }
+	static void store(std::int32_t* target, Register value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(target), value); }
+
+	static Register minimum(Register a, Register b)  //SSE2 has no 32 bit integer min and max,they are built from a compare and a blend
+	{
+		__m128i aIsGreater = _mm_cmpgt_epi32(a, b);
+		return _mm_or_si128(_mm_and_si128(aIsGreater, b), _mm_andnot_si128(aIsGreater, a));
+	}
+
+	static Register maximum(Register a, Register b)
+	{
+		__m128i aIsGreater = _mm_cmpgt_epi32(a, b);
+		return _mm_or_si128(_mm_and_si128(aIsGreater, a), _mm_andnot_si128(aIsGreater, b));
+	}
+
+	template<SimdCompare Compare>
+	static unsigned compare(Register elements, Register value)
+	{
+		__m128i mask;
+		if constexpr (Compare == SimdCompare::Equal || Compare == SimdCompare::NotEqual)
+			mask = _mm_cmpeq_epi32(elements, value);
+		else if constexpr (Compare == SimdCompare::Less)
+			mask = _mm_cmplt_epi32(elements, value);
+		else
+			mask = _mm_cmpgt_epi32(elements, value);
+
+		unsigned bits = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(mask)));
+		return Compare == SimdCompare::NotEqual ? ~bits & 0xFu : bits;
+	}
+
+	static SumRegister zeroSum() { return _mm_setzero_si128(); }
+
+	static SumRegister addToSum(SumRegister sum, Register elements)  //the elements are sign extended to 64 bits by interleaving them with their sign
+	{
+		__m128i sign = _mm_srai_epi32(elements, 31);
+		sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(elements, sign));
+		return _mm_add_epi64(sum, _mm_unpackhi_epi32(elements, sign));
+	}
+
+	static std::int64_t reduceSum(SumRegister sum)
+	{
+		alignas(16) std::int64_t lanes[2];
+		_mm_store_si128(reinterpret_cast<__m128i*>(lanes), sum);
+		return lanes[0] + lanes[1];
+	}
+};
+
+template<>
+struct SimdVector<float>
+{
+	static constexpr bool mEnabled = true;
+	static constexpr std::size_t mWidth = 4;
+	using Register = __m128;
+	using SumRegister = __m128;
+
+	static Register load(const float* source) { return _mm_loadu_ps(source); }
+	static Register broadcast(float value) { return _mm_set1_ps(value); }
+	static void store(float* target, Register value) { _mm_storeu_ps(target, value); }
+	static Register minimum(Register a, Register b) { return _mm_min_ps(a, b); }
+	static Register maximum(Register a, Register b) { return _mm_max_ps(a, b); }
+
+	template<SimdCompare Compare>
+	static unsigned compare(Register elements, Register value)
+	{
+		if constexpr (Compare == SimdCompare::Equal)
+			return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(elements, value)));
+		else if constexpr (Compare == SimdCompare::NotEqual)
+			return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpneq_ps(elements, value)));
+		else if constexpr (Compare == SimdCompare::Less)
+			return static_cast<unsigned>(_mm_movemask_ps(_mm_cmplt_ps(elements, value)));
+		else
+			return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpgt_ps(elements, value)));
+	}
+
+	static SumRegister zeroSum() { return _mm_setzero_ps(); }
+	static SumRegister addToSum(SumRegister sum, Register elements) { return _mm_add_ps(sum, elements); }
+
+	static float reduceSum(SumRegister sum)
+	{
+		alignas(16) float lanes[4];
+		_mm_store_ps(lanes, sum);
+		return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+	}
+};
+
+template<>
+struct SimdVector<double>
+{
+	static constexpr bool mEnabled = true;
+	static constexpr std::size_t mWidth = 2;
+	using Register = __m128d;
+	using SumRegister = __m128d;
+
+	static Register load(const double* source) { return _mm_loadu_pd(source); }
+	static Register broadcast(double value) { return _mm_set1_pd(value); }
+	static void store(double* target, Register value) { _mm_storeu_pd(target, value); }
+	static Register minimum(Register a, Register b) { return _mm_min_pd(a, b); }
+	static Register maximum(Register a, Register b) { return _mm_max_pd(a, b); }
+
+	template<SimdCompare Compare>
+	static unsigned compare(Register elements, Register value)
+	{
+		if constexpr (Compare == SimdCompare::Equal)
+			return static_cast<unsigned>(_mm_movemask_pd(_mm_cmpeq_pd(elements, value)));
+		else if constexpr (Compare == SimdCompare::NotEqual)
+			return static_cast<unsigned>(_mm_movemask_pd(_mm_cmpneq_pd(elements, value)));
+		else if constexpr (Compare == SimdCompare::Less)
+			return static_cast<unsigned>(_mm_movemask_pd(_mm_cmplt_pd(elements, value)));
+		else
+			return static_cast<unsigned>(_mm_movemask_pd(_mm_cmpgt_pd(elements, value)));
+	}
+
+	static SumRegister zeroSum() { return _mm_setzero_pd(); }
+	static SumRegister addToSum(SumRegister sum, Register elements) { return _mm_add_pd(sum, elements); }
+
+	static double reduceSum(SumRegister sum)
+	{
+		alignas(16) double lanes[2];
+		_mm_store_pd(lanes, sum);
+		return lanes[0] + lanes[1];
+	}
+};
+
+#endif
+
+//returns an iterator to the first element equal to value,or end() if there is no such element
+template<typename DequeType>
+auto simd_find(DequeType& deque, const typename DequeType::value_type& value) -> decltype(deque.begin())
+{
+	using T = typename DequeType::value_type;
+	using Vector = SimdVector<T>;
+
+	std::size_t index = 0;
+	for (auto segment : deque.segments())
+	{
+		std::size_t i = 0;
+		if constexpr (Vector::mEnabled)
+		{
+			auto needle = Vector::broadcast(value);
+			for (; i + Vector::mWidth <= segment.size(); i += Vector::mWidth)
+			{
+				unsigned mask = Vector::template compare<SimdCompare::Equal>(Vector::load(segment.data() + i), needle);
+				if (mask != 0)  //the lowest set bit is the first matching lane
+					return deque.begin() + (index + i + std::countr_zero(mask));
+			}
+		}
+		for (; i < segment.size(); i++)
+		{
+			if (segment[i] == value)
+				return deque.begin() + (index + i);
+		}
+		index += segment.size();
+	}
+
+	return deque.end();
+}
+
+//returns the number of elements equal to value
+template<typename DequeType>
+std::size_t simd_count(const DequeType& deque, const typename DequeType::value_type& value)
+{
+	using T = typename DequeType::value_type;
+	using Vector = SimdVector<T>;
+
+	std::size_t count = 0;
+	for (auto segment : deque.segments())
+	{
+		std::size_t i = 0;
+		if constexpr (Vector::mEnabled)
+		{
+			auto needle = Vector::broadcast(value);
+			for (; i + Vector::mWidth <= segment.size(); i += Vector::mWidth)
+				count += simdCountLanes(Vector::template compare<SimdCompare::Equal>(Vector::load(segment.data() + i), needle));
+		}
+		for (; i < segment.size(); i++)
+			count += segment[i] == value;
+	}
+
+	return count;
+}
+
+//returns the sum of all elements,0 for an empty deque.Floating point values are added in a different order than a sequential loop,so the last bits of the result can differ from std::accumulate
+template<typename DequeType>
+SimdSumType<typename DequeType::value_type> simd_sum(const DequeType& deque)
+{
+	using T = typename DequeType::value_type;
+	using Vector = SimdVector<T>;
+
+	SimdSumType<T> sum = 0;
+	if constexpr (Vector::mEnabled)
+	{
+		auto vectorSum = Vector::zeroSum();  //the vector accumulator is carried across the blocks and reduced once at the end
+		for (auto segment : deque.segments())
+		{
+			std::size_t i = 0;
+			for (; i + Vector::mWidth <= segment.size(); i += Vector::mWidth)
+				vectorSum = Vector::addToSum(vectorSum, Vector::load(segment.data() + i));
+			for (; i < segment.size(); i++)
+				sum += segment[i];
+		}
+		sum += Vector::reduceSum(vectorSum);
+	}
+	else
+	{
+		for (auto segment : deque.segments())
+			for (const T& element : segment)
+				sum += element;
+	}
+
+	return sum;
+}
+
+template<bool FindMaximum, typename DequeType>
+typename DequeType::value_type simdExtreme(const DequeType& deque)
+{
+	using T = typename DequeType::value_type;
+	using Vector = SimdVector<T>;
+
+	if (deque.empty())
+		throw std::out_of_range("Deque is empty, cannot compute an extreme element.");
+
+	T result = *deque.begin();
+	auto pick = [](const T& current, const T& element) { return FindMaximum ? (current < element ? element : current) : (element < current ? element : current); };
+	if constexpr (Vector::mEnabled)
+	{
+		auto vectorResult = Vector::broadcast(result);
+		for (auto segment : deque.segments())
+		{
+			std::size_t i = 0;
+			for (; i + Vector::mWidth <= segment.size(); i += Vector::mWidth)
+			{
+				if constexpr (FindMaximum)
+					vectorResult = Vector::maximum(vectorResult, Vector::load(segment.data() + i));
+				else
+					vectorResult = Vector::minimum(vectorResult, Vector::load(segment.data() + i));
+			}
+			for (; i < segment.size(); i++)
+				result = pick(result, segment[i]);
+		}
+
+		T lanes[Vector::mWidth];
+		Vector::store(lanes, vectorResult);
+		for (const T& lane : lanes)
+			result = pick(result, lane);
+	}
+	else
+	{
+		for (auto segment : deque.segments())
+			for (const T& element : segment)
+				result = pick(result, element);
+	}
+
+	return result;
+}
+
+//return the smallest and the largest element,they throw std::out_of_range on an empty deque like front() does.With NaNs in a floating point deque the result is unspecified
+template<typename DequeType>
+typename DequeType::value_type simd_min(const DequeType& deque)
+{
+	return simdExtreme<false>(deque);
+}
+
+template<typename DequeType>
+typename DequeType::value_type simd_max(const DequeType& deque)
+{
+	return simdExtreme<true>(deque);
+}
+
+template<SimdCompare Compare, typename DequeType>
+bool simdAnyOf(const DequeType& deque, const typename DequeType::value_type& value)
+{
+	using T = typename DequeType::value_type;
+	using Vector = SimdVector<T>;
+
+	for (auto segment : deque.segments())
+	{
+		std::size_t i = 0;
+		if constexpr (Vector::mEnabled)
+		{
+			auto operand = Vector::broadcast(value);
+			for (; i + Vector::mWidth <= segment.size(); i += Vector::mWidth)
+			{
+				if (Vector::template compare<Compare>(Vector::load(segment.data() + i), operand) != 0)
+					return true;
+			}
+		}
+		for (; i < segment.size(); i++)
+		{
+			if (simdCompareScalar<Compare>(segment[i], value))
+				return true;
+		}
+	}
+
+	return false;
+}
+
+//returns true if any element compares to value the given way,for example simd_any_of(deque, SimdCompare::Greater, limit) checks if an element is above limit
+template<typename DequeType>
+bool simd_any_of(const DequeType& deque, SimdCompare compare, const typename DequeType::value_type& value)
+{
+	switch (compare)  //the comparison is a template parameter of the kernel,so the inner loop doesn't branch on it
+	{
+	case SimdCompare::Equal:
+		return simdAnyOf<SimdCompare::Equal>(deque, value);
+	case SimdCompare::NotEqual:
+		return simdAnyOf<SimdCompare::NotEqual>(deque, value);
+	case SimdCompare::Less:
+		return simdAnyOf<SimdCompare::Less>(deque, value);
+	default:
+		return simdAnyOf<SimdCompare::Greater>(deque, value);
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include<cstddef>
+
+//the events a Deque counts when it is instantiated with CountingDequeStats
+struct DequeCounters
+{
+	std::size_t blockAllocations = 0;  //blocks allocated from the allocator
+	std::size_t blockDeallocations = 0;  //blocks returned to the allocator
+	std::size_t blockReuses = 0;  //pushes that took a spare or an idle block instead of allocating one
+	std::size_t blockClones = 0;  //shared blocks that were copied before a write
+	std::size_t clonedElements = 0;  //the elements those copies constructed
+	std::size_t mapReallocations = 0;  //block directories that were allocated to grow or shrink the directory
+	std::size_t mapRecenters = 0;  //times the used part of the directory was moved to its middle instead of growing it
+	std::size_t elementShifts = 0;  //elements moved by insert,remove and erase to open or close a gap
+};
+
+//a snapshot returned by Deque::stats().The counters are zero unless the deque counts them,the footprint is always filled in
+struct DequeStats : DequeCounters
+{
+	std::size_t size = 0;
+	std::size_t usedBlocks = 0;  //blocks that hold elements
+	std::size_t idleBlocks = 0;  //empty blocks kept in the directory for the next pushes
+	std::size_t spareBlocks = 0;  //empty blocks kept outside the directory for reuse
+	std::size_t mapCapacity = 0;  //slots in the block directory
+	std::size_t blockBytes = 0;  //the size of one block,including its reference count and padding
+	std::size_t footprintBytes = 0;  //the deque object,its directory and every block it holds.A block shared with a copy is counted by both deques
+	std::size_t elementBytes = 0;  //size * sizeof(T),so footprintBytes - elementBytes is the overhead
+};
+
+//the default stats policy,it counts nothing and its calls compile to nothing
+struct NoDequeStats
+{
+	static constexpr bool enabled = false;
+
+	void count(std::size_t DequeCounters::*, std::size_t = 1) {}
+
+	DequeCounters counters() const { return DequeCounters(); }
+
+	void reset() {}
+};
+
+//counts the events of one deque.The counters are plain integers,like the rest of the deque they must not be updated from two threads at once
+struct CountingDequeStats
+{
+	static constexpr bool enabled = true;
+
+	DequeCounters values;
+
+	void count(std::size_t DequeCounters::* counter, std::size_t amount = 1) { values.*counter += amount; }
+
+	DequeCounters counters() const { return values; }
+
+	void reset() { values = DequeCounters(); }
+};
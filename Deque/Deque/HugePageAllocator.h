@@ -0,0 +1,197 @@
+#pragma once
+#include<cstddef>
+#include<cstdint>
+#include<mutex>
+#include<new>
+#if defined(__unix__) || defined(__APPLE__)
+#include<sys/mman.h>
+#define DEQUE_HUGE_PAGES_MMAP 1
+#endif
+
+//a process-wide arena that carves chunks out of 2 MB regions.On Linux the regions are aligned to 2 MB and marked with MADV_HUGEPAGE,so the blocks of a deque that uses HugePageAllocator share a few TLB entries instead of needing one per 4 KB page.Where mmap isn't available the chunks come from operator new
+class HugePageArena
+{
+	static constexpr std::size_t mRegionBytes = std::size_t(2) << 20;
+	static constexpr std::size_t mChunkAlignment = 64;
+	static constexpr std::size_t mMaxSizeClasses = 8;
+
+	struct FreeChunk
+	{
+		FreeChunk* next;
+	};
+
+	struct SizeClass
+	{
+		std::size_t bytes;
+		FreeChunk* head;
+	};
+
+	std::mutex mutex;
+	SizeClass sizeClasses[mMaxSizeClasses];
+	std::size_t sizeClassCount;
+	unsigned char* regionPosition;
+	unsigned char* regionEnd;
+
+	HugePageArena() : sizeClasses(), sizeClassCount(0), regionPosition(nullptr), regionEnd(nullptr) {}
+
+	SizeClass* findSizeClass(std::size_t bytes);
+
+	static std::size_t chunkBytes(std::size_t bytes);
+
+	static bool isArenaSized(std::size_t bytes, std::size_t alignment);
+
+	static unsigned char* mapRegion();
+
+public:
+	HugePageArena(const HugePageArena&) = delete;
+	HugePageArena& operator=(const HugePageArena&) = delete;
+
+	static HugePageArena& instance();
+
+	void* allocate(std::size_t bytes, std::size_t alignment);
+
+	void deallocate(void* pointer, std::size_t bytes, std::size_t alignment);
+};
+
+//an allocator that takes its memory from the HugePageArena.Freed chunks are kept for reuse by any deque of any thread,and the regions are given back to the system only when the process exits
+template<typename T>
+class HugePageAllocator
+{
+public:
+	using value_type = T;
+
+	HugePageAllocator() noexcept {}
+
+	template<typename U>
+	HugePageAllocator(const HugePageAllocator<U>&) noexcept {}
+
+	T* allocate(std::size_t count);
+
+	void deallocate(T* pointer, std::size_t count);
+
+	template<typename U>
+	bool operator==(const HugePageAllocator<U>&) const noexcept { return true; }
+
+	template<typename U>
+	bool operator!=(const HugePageAllocator<U>&) const noexcept { return false; }
+};
+
+inline HugePageArena& HugePageArena::instance()
+{
+	static HugePageArena* arena = new HugePageArena();  //never destroyed,so deques with static storage duration can still free their blocks at exit
+	return *arena;
+}
+
+inline std::size_t HugePageArena::chunkBytes(std::size_t bytes)
+{
+	return (bytes + mChunkAlignment - 1) / mChunkAlignment * mChunkAlignment;
+}
+
+inline bool HugePageArena::isArenaSized(std::size_t bytes, std::size_t alignment)
+{
+	return bytes > 0 && alignment <= mChunkAlignment && chunkBytes(bytes) <= mRegionBytes / 8;  //large requests would waste most of a region
+}
+
+inline HugePageArena::SizeClass* HugePageArena::findSizeClass(std::size_t bytes)
+{
+	for (std::size_t i = 0; i < sizeClassCount; i++)
+		if (sizeClasses[i].bytes == bytes)
+			return &sizeClasses[i];
+
+	if (sizeClassCount == mMaxSizeClasses)  //classes are never removed,so a size that finds no class here didn't find one when it was allocated either
+		return nullptr;
+
+	sizeClasses[sizeClassCount] = SizeClass{ bytes, nullptr };
+	return &sizeClasses[sizeClassCount++];
+}
+
+inline unsigned char* HugePageArena::mapRegion()
+{
+#ifdef DEQUE_HUGE_PAGES_MMAP
+	//maps twice the region size and unmaps what lies outside a 2 MB aligned region,because mmap only aligns to the page size
+	std::size_t mappedBytes = 2 * mRegionBytes;
+	void* mapping = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (mapping == MAP_FAILED)
+		throw std::bad_alloc();
+
+	std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(mapping);
+	std::uintptr_t alignedBegin = (begin + mRegionBytes - 1) / mRegionBytes * mRegionBytes;
+	if (alignedBegin != begin)
+		munmap(mapping, alignedBegin - begin);
+	std::uintptr_t alignedEnd = alignedBegin + mRegionBytes;
+	if (begin + mappedBytes != alignedEnd)
+		munmap(reinterpret_cast<void*>(alignedEnd), begin + mappedBytes - alignedEnd);
+
+	unsigned char* region = reinterpret_cast<unsigned char*>(alignedBegin);
+#ifdef MADV_HUGEPAGE
+	madvise(region, mRegionBytes, MADV_HUGEPAGE);  //only a hint,the kernel falls back to 4 KB pages when transparent huge pages are off
+#endif
+	return region;
+#else
+	return static_cast<unsigned char*>(::operator new(mRegionBytes, std::align_val_t(mChunkAlignment)));
+#endif
+}
+
+inline void* HugePageArena::allocate(std::size_t bytes, std::size_t alignment)
+{
+	if (!isArenaSized(bytes, alignment))
+		return ::operator new(bytes, std::align_val_t(alignment > mChunkAlignment ? alignment : mChunkAlignment));
+
+	std::size_t chunk = chunkBytes(bytes);
+	std::lock_guard<std::mutex> lock(mutex);
+	SizeClass* sizeClass = findSizeClass(chunk);
+	if (sizeClass == nullptr)  //when every size class is taken,the chunks of this size come from operator new,so they can be freed instead of being lost to the arena
+		return ::operator new(bytes, std::align_val_t(mChunkAlignment));
+
+	if (sizeClass->head != nullptr)
+	{
+		FreeChunk* freeChunk = sizeClass->head;
+		sizeClass->head = freeChunk->next;
+		return freeChunk;
+	}
+
+	if (regionPosition == nullptr || static_cast<std::size_t>(regionEnd - regionPosition) < chunk)  //the rest of the current region is left unused
+	{
+		regionPosition = mapRegion();
+		regionEnd = regionPosition + mRegionBytes;
+	}
+	void* result = regionPosition;
+	regionPosition += chunk;
+	return result;
+}
+
+inline void HugePageArena::deallocate(void* pointer, std::size_t bytes, std::size_t alignment)
+{
+	if (!isArenaSized(bytes, alignment))
+	{
+		::operator delete(pointer, std::align_val_t(alignment > mChunkAlignment ? alignment : mChunkAlignment));
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	SizeClass* sizeClass = findSizeClass(chunkBytes(bytes));
+	if (sizeClass == nullptr)
+	{
+		::operator delete(pointer, std::align_val_t(mChunkAlignment));
+		return;
+	}
+	sizeClass->head = ::new(pointer) FreeChunk{ sizeClass->head };
+}
+
+//only single objects like the blocks of a deque come from the arena.Arrays like the block directory take a new size every time they grow and would use up the size classes
+template<typename T>
+T* HugePageAllocator<T>::allocate(std::size_t count)
+{
+	if (count != 1)
+		return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+	return static_cast<T*>(HugePageArena::instance().allocate(sizeof(T), alignof(T)));
+}
+
+template<typename T>
+void HugePageAllocator<T>::deallocate(T* pointer, std::size_t count)
+{
+	if (count != 1)
+		::operator delete(pointer, std::align_val_t(alignof(T)));
+	else
+		HugePageArena::instance().deallocate(pointer, sizeof(T), alignof(T));
+}
@@ -0,0 +1,246 @@
+#pragma once
+#include"Deque.h"
+#include<algorithm>
+#include<cstddef>
+#include<cstdint>
+#include<functional>
+#include<iterator>
+#include<stdexcept>
+#include<utility>
+
+//sliding windows over a stream of values.Values are pushed at the back and evicted from the front,either by count or by timestamp,and the window answers a query in O(1).Timestamps must not decrease from one push to the next
+
+//the minimum or maximum of a window.Only the values that can still become the extremum are kept:a pushed value removes the values before it that are not better than it,so the kept values are ordered by Compare from the front to the back and the front is the answer.Every value is pushed and popped once,so push and evict are amortized O(1)
+//a window is evicted either by count with evict or by timestamp with evict_before,because the values that were removed by a later value don't keep their timestamps
+template<typename T, typename Compare, typename Timestamp = std::int64_t>
+class MonotonicWindow
+{
+	struct Entry
+	{
+		T value;
+		Timestamp time;
+		std::uint64_t sequence;  //the position of the value in the stream,evict counts with it
+	};
+
+	Deque<Entry> entries;
+	Compare compare;
+	std::uint64_t firstSequence;  //the position of the oldest value that is still in the window
+	std::uint64_t nextSequence;
+
+public:
+	explicit MonotonicWindow(Compare compare = Compare());
+
+	void push(const T& value, Timestamp time = Timestamp());
+
+	//pushes a batch of values with the same timestamp
+	template<std::input_iterator InputIterator>
+	void push(InputIterator first, InputIterator last, Timestamp time = Timestamp());
+
+	//evicts the count oldest values of the window
+	void evict(std::size_t count = 1);
+
+	//evicts the values that were pushed with a timestamp before time
+	void evict_before(Timestamp time);
+
+	//the minimum for SlidingWindowMin and the maximum for SlidingWindowMax,throws std::out_of_range if the window is empty
+	const T& query() const;
+
+	bool empty() const;
+
+	void clear();
+};
+
+template<typename T, typename Timestamp = std::int64_t>
+using SlidingWindowMin = MonotonicWindow<T, std::less<T>, Timestamp>;
+
+template<typename T, typename Timestamp = std::int64_t>
+using SlidingWindowMax = MonotonicWindow<T, std::greater<T>, Timestamp>;
+
+//the aggregate of a window for any associative operation,like a sum,a product or a gcd.The window is kept as two stacks in one deque:the values at the front store the aggregate from themselves to the end of the front part,the values at the back store the aggregate from the start of the back part to themselves.A query combines the two in O(1),and when the front part runs out the whole window becomes the front part in one pass from the back,so every value is combined a constant number of times and push,evict and query are amortized O(1).Op doesn't need to be commutative or to have an inverse,so a floating point sum doesn't collect the error of subtracting the evicted values
+template<typename T, typename Op, typename Timestamp = std::int64_t>
+class SlidingWindowAggregate
+{
+	struct Entry
+	{
+		T value;
+		T aggregate;
+		Timestamp time;
+	};
+
+	Deque<Entry> entries;
+	Op op;
+	std::size_t frontCount;  //the entries [0, frontCount) are the front part
+
+	void flip();
+
+	void evictFront();
+
+public:
+	explicit SlidingWindowAggregate(Op op = Op());
+
+	void push(const T& value, Timestamp time = Timestamp());
+
+	template<std::input_iterator InputIterator>
+	void push(InputIterator first, InputIterator last, Timestamp time = Timestamp());
+
+	void evict(std::size_t count = 1);
+
+	void evict_before(Timestamp time);
+
+	//op applied to the values of the window from the oldest to the newest,throws std::out_of_range if the window is empty
+	T query() const;
+
+	std::size_t size() const;
+
+	bool empty() const;
+
+	void clear();
+};
+
+template<typename T, typename Timestamp = std::int64_t>
+using SlidingWindowSum = SlidingWindowAggregate<T, std::plus<T>, Timestamp>;
+
+template<typename T, typename Compare, typename Timestamp>
+MonotonicWindow<T, Compare, Timestamp>::MonotonicWindow(Compare compare) : compare(std::move(compare)), firstSequence(0), nextSequence(0) {}
+
+template<typename T, typename Compare, typename Timestamp>
+void MonotonicWindow<T, Compare, Timestamp>::push(const T& value, Timestamp time)
+{
+	while (!entries.empty() && !compare(std::as_const(entries).back().value, value))  //a value that is not better than the new one can never be the answer again
+		entries.pop_back();
+	entries.push_back(Entry{ value, time, nextSequence });
+	nextSequence++;
+}
+
+template<typename T, typename Compare, typename Timestamp>
+template<std::input_iterator InputIterator>
+void MonotonicWindow<T, Compare, Timestamp>::push(InputIterator first, InputIterator last, Timestamp time)
+{
+	for (; first != last; ++first)
+		push(*first, time);
+}
+
+template<typename T, typename Compare, typename Timestamp>
+void MonotonicWindow<T, Compare, Timestamp>::evict(std::size_t count)
+{
+	firstSequence = std::min(firstSequence + count, nextSequence);
+	while (!entries.empty() && std::as_const(entries).front().sequence < firstSequence)
+		entries.pop_front();
+}
+
+template<typename T, typename Compare, typename Timestamp>
+void MonotonicWindow<T, Compare, Timestamp>::evict_before(Timestamp time)
+{
+	while (!entries.empty() && std::as_const(entries).front().time < time)
+		entries.pop_front();
+}
+
+template<typename T, typename Compare, typename Timestamp>
+const T& MonotonicWindow<T, Compare, Timestamp>::query() const
+{
+	if (entries.empty())
+		throw std::out_of_range("Window is empty");
+	return entries.front().value;
+}
+
+template<typename T, typename Compare, typename Timestamp>
+bool MonotonicWindow<T, Compare, Timestamp>::empty() const
+{
+	return entries.empty();  //the best value of a window is always kept,so the window is empty exactly when no value is kept
+}
+
+template<typename T, typename Compare, typename Timestamp>
+void MonotonicWindow<T, Compare, Timestamp>::clear()
+{
+	entries.clear();
+	firstSequence = nextSequence;
+}
+
+template<typename T, typename Op, typename Timestamp>
+SlidingWindowAggregate<T, Op, Timestamp>::SlidingWindowAggregate(Op op) : op(std::move(op)), frontCount(0) {}
+
+template<typename T, typename Op, typename Timestamp>
+void SlidingWindowAggregate<T, Op, Timestamp>::push(const T& value, Timestamp time)
+{
+	if (entries.size() == frontCount)  //the value starts the back part
+		entries.push_back(Entry{ value, value, time });
+	else
+		entries.push_back(Entry{ value, op(std::as_const(entries).back().aggregate, value), time });
+}
+
+template<typename T, typename Op, typename Timestamp>
+template<std::input_iterator InputIterator>
+void SlidingWindowAggregate<T, Op, Timestamp>::push(InputIterator first, InputIterator last, Timestamp time)
+{
+	for (; first != last; ++first)
+		push(*first, time);
+}
+
+template<typename T, typename Op, typename Timestamp>
+void SlidingWindowAggregate<T, Op, Timestamp>::flip()
+{
+	//the front part is empty,so every entry becomes part of it and gets the aggregate from itself to the newest value
+	std::size_t count = entries.size();
+	if (count == 0)
+		return;
+
+	entries[count - 1].aggregate = entries[count - 1].value;
+	for (std::size_t i = count - 1; i > 0; i--)
+		entries[i - 1].aggregate = op(entries[i - 1].value, entries[i].aggregate);
+	frontCount = count;
+}
+
+template<typename T, typename Op, typename Timestamp>
+void SlidingWindowAggregate<T, Op, Timestamp>::evictFront()
+{
+	if (frontCount == 0)
+		flip();
+	entries.pop_front();
+	frontCount--;
+}
+
+template<typename T, typename Op, typename Timestamp>
+void SlidingWindowAggregate<T, Op, Timestamp>::evict(std::size_t count)
+{
+	for (std::size_t i = 0; i < count && !entries.empty(); i++)
+		evictFront();
+}
+
+template<typename T, typename Op, typename Timestamp>
+void SlidingWindowAggregate<T, Op, Timestamp>::evict_before(Timestamp time)
+{
+	while (!entries.empty() && std::as_const(entries).front().time < time)
+		evictFront();
+}
+
+template<typename T, typename Op, typename Timestamp>
+T SlidingWindowAggregate<T, Op, Timestamp>::query() const
+{
+	if (entries.empty())
+		throw std::out_of_range("Window is empty");
+
+	if (frontCount == 0)
+		return entries.back().aggregate;
+	if (frontCount == entries.size())
+		return entries.front().aggregate;
+	return op(entries.front().aggregate, entries.back().aggregate);
+}
+
+template<typename T, typename Op, typename Timestamp>
+std::size_t SlidingWindowAggregate<T, Op, Timestamp>::size() const
+{
+	return entries.size();
+}
+
+template<typename T, typename Op, typename Timestamp>
+bool SlidingWindowAggregate<T, Op, Timestamp>::empty() const
+{
+	return entries.empty();
+}
+
+template<typename T, typename Op, typename Timestamp>
+void SlidingWindowAggregate<T, Op, Timestamp>::clear()
+{
+	entries.clear();
+	frontCount = 0;
+}
@@ -0,0 +1,805 @@
+#pragma once
+#include"Deque.h"
+#include<cstddef>
+#include<iterator>
+#include<memory>
+#include<new>
+#include<stdexcept>
+#include<type_traits>
+#include<utility>
+
+//a deque that keeps up to InlineN elements inside the object as a ring and only moves them to the blocks of a Deque when a push doesn't fit,so a short queue is constructed,used and destroyed without touching the heap.The elements are either all inline or all in the Deque,and when the Deque is emptied the next pushes go inline again.The Deque keeps its directory and spare blocks,so a queue that keeps crossing InlineN doesn't allocate every time it spills.The interface is the one of BoundedDeque
+template<typename T, std::size_t InlineN = 16, std::size_t BlockBytes = 512, typename Allocator = std::allocator<T>>
+class SmallDeque
+{
+	static_assert(InlineN > 0, "SmallDeque needs room for at least one inline element");
+
+	using AllocatorTraits = std::allocator_traits<Allocator>;
+
+	[[no_unique_address]] Allocator allocator;
+
+	static constexpr std::size_t mSpilled = InlineN + 1;  //inlineCount while the elements are in the Deque,so the fast paths of push_* and pop_* tell the three states apart with one comparison
+
+	//the inline element at index i is in slot (head + i) mod InlineN
+	std::size_t head;
+	std::size_t inlineCount;
+	alignas(T) unsigned char storage[sizeof(T) * InlineN];
+
+	Deque<T, BlockBytes, Allocator> heap;  //holds the elements once they outgrew the inline slots and is empty while they are inline,inlineCount is mSpilled exactly when it isn't empty.An empty Deque owns no memory until its first push
+
+	T* slotAddress(std::size_t slot);
+
+	const T* slotAddress(std::size_t slot) const;
+
+	T* inlineAddress(std::size_t index);
+
+	const T* inlineAddress(std::size_t index) const;
+
+	T* elementAddress(std::size_t index);
+
+	const T* elementAddress(std::size_t index) const;
+
+	void spill();
+
+	void destroyInline();
+
+public:
+	//an iterator is a position counted from the front,so it stays valid when the elements move from the inline slots to the Deque
+	template<bool IsConst>
+	class BasicIterator
+	{
+		friend class SmallDeque;
+		friend class BasicIterator<!IsConst>;
+
+		using DequePointer = std::conditional_t<IsConst, const SmallDeque*, SmallDeque*>;
+
+		DequePointer deque;
+		std::size_t index;
+
+		BasicIterator(DequePointer deque, std::size_t index) : deque(deque), index(index) {}
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using iterator_concept = std::random_access_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<IsConst, const T*, T*>;
+		using reference = std::conditional_t<IsConst, const T&, T&>;
+
+		BasicIterator() : deque(nullptr), index(0) {}
+
+		template<bool OtherIsConst, typename = std::enable_if_t<IsConst && !OtherIsConst>>
+		BasicIterator(const BasicIterator<OtherIsConst>& other) : deque(other.deque), index(other.index) {}
+
+		reference operator*() const;
+		pointer operator->() const;
+		reference operator[](difference_type steps) const;
+		BasicIterator& operator++();
+		BasicIterator& operator--();
+		BasicIterator operator++(int);
+		BasicIterator operator--(int);
+		BasicIterator& operator+=(difference_type steps);
+		BasicIterator& operator-=(difference_type steps);
+		BasicIterator operator+(difference_type steps) const;
+		BasicIterator operator-(difference_type steps) const;
+
+		template<bool OtherIsConst>
+		difference_type operator-(const BasicIterator<OtherIsConst>& other) const;
+
+		template<bool OtherIsConst>
+		bool operator==(const BasicIterator<OtherIsConst>& other) const;
+
+		template<bool OtherIsConst>
+		bool operator!=(const BasicIterator<OtherIsConst>& other) const;
+
+		template<bool OtherIsConst>
+		bool operator<(const BasicIterator<OtherIsConst>& other) const;
+
+		template<bool OtherIsConst>
+		bool operator>(const BasicIterator<OtherIsConst>& other) const;
+
+		template<bool OtherIsConst>
+		bool operator<=(const BasicIterator<OtherIsConst>& other) const;
+
+		template<bool OtherIsConst>
+		bool operator>=(const BasicIterator<OtherIsConst>& other) const;
+
+		friend BasicIterator operator+(difference_type steps, const BasicIterator& it) { return it + steps; }
+	};
+
+	using Iterator = BasicIterator<false>;
+	using ConstIterator = BasicIterator<true>;
+
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = T&;
+	using const_reference = const T&;
+	using iterator = Iterator;
+	using const_iterator = ConstIterator;
+	using reverse_iterator = std::reverse_iterator<Iterator>;
+	using const_reverse_iterator = std::reverse_iterator<ConstIterator>;
+	using allocator_type = Allocator;
+
+	SmallDeque();
+
+	explicit SmallDeque(const Allocator& allocator);
+
+	SmallDeque(const SmallDeque& other);
+
+	SmallDeque(SmallDeque&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+	~SmallDeque();
+
+	SmallDeque& operator=(const SmallDeque& other);
+
+	SmallDeque& operator=(SmallDeque&& other) noexcept(std::is_nothrow_move_constructible_v<T> && (std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value || std::allocator_traits<Allocator>::is_always_equal::value));
+
+	void push_back(const T& value);
+
+	void push_back(T&& value);
+
+	void push_front(const T& value);
+
+	void push_front(T&& value);
+
+	template<typename... Args>
+	T& emplace_back(Args&&... args);
+
+	template<typename... Args>
+	T& emplace_front(Args&&... args);
+
+	void pop_back();
+
+	void pop_front();
+
+	T& front();
+
+	const T& front() const;
+
+	T& back();
+
+	const T& back() const;
+
+	T& operator[](std::size_t index);
+
+	const T& operator[](std::size_t index) const;
+
+	bool empty() const;
+
+	//true while the elements are stored inside the object,an empty deque is inline
+	bool is_inline() const;
+
+	void clear();
+
+	std::size_t size() const;
+
+	Iterator begin();
+
+	Iterator end();
+
+	ConstIterator begin() const;
+
+	ConstIterator end() const;
+
+	ConstIterator cbegin() const;
+
+	ConstIterator cend() const;
+
+	reverse_iterator rbegin();
+
+	reverse_iterator rend();
+
+	const_reverse_iterator rbegin() const;
+
+	const_reverse_iterator rend() const;
+
+	Allocator get_allocator() const;
+};
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+SmallDeque<T, InlineN, BlockBytes, Allocator>::SmallDeque() : SmallDeque(Allocator()) {}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+SmallDeque<T, InlineN, BlockBytes, Allocator>::SmallDeque(const Allocator& allocator) : allocator(allocator), head(0), inlineCount(0), heap(allocator) {}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+SmallDeque<T, InlineN, BlockBytes, Allocator>::SmallDeque(const SmallDeque& other) : allocator(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.allocator)), head(0), inlineCount(0), heap(other.heap)
+{
+	if (other.inlineCount == mSpilled)
+	{
+		inlineCount = mSpilled;
+		return;
+	}
+
+	try
+	{
+		for (; inlineCount < other.inlineCount; inlineCount++)
+			AllocatorTraits::construct(allocator, slotAddress(inlineCount), *other.inlineAddress(inlineCount));
+	}
+	catch (...)  //the destructor doesn't run for a constructor that throws
+	{
+		destroyInline();
+		throw;
+	}
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+SmallDeque<T, InlineN, BlockBytes, Allocator>::SmallDeque(SmallDeque&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : allocator(other.allocator), head(0), inlineCount(0), heap(std::move(other.heap))
+{
+	if (other.inlineCount == mSpilled)
+	{
+		inlineCount = mSpilled;
+		other.inlineCount = 0;
+		return;
+	}
+
+	if constexpr (std::is_nothrow_move_constructible_v<T>)  //the inline elements can't be handed over,they are moved one by one
+	{
+		for (; inlineCount < other.inlineCount; inlineCount++)
+			AllocatorTraits::construct(allocator, slotAddress(inlineCount), std::move(*other.inlineAddress(inlineCount)));
+	}
+	else
+	{
+		try
+		{
+			for (; inlineCount < other.inlineCount; inlineCount++)
+				AllocatorTraits::construct(allocator, slotAddress(inlineCount), std::move(*other.inlineAddress(inlineCount)));
+		}
+		catch (...)
+		{
+			destroyInline();
+			throw;
+		}
+	}
+	other.destroyInline();
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+SmallDeque<T, InlineN, BlockBytes, Allocator>::~SmallDeque()
+{
+	if (inlineCount != mSpilled)
+		destroyInline();
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+SmallDeque<T, InlineN, BlockBytes, Allocator>& SmallDeque<T, InlineN, BlockBytes, Allocator>::operator=(const SmallDeque& other)
+{
+	if (this == &other)  //prevent self-assignment
+		return *this;
+
+	clear();
+	heap = other.heap;
+	if constexpr (AllocatorTraits::propagate_on_container_copy_assignment::value)
+		allocator = other.allocator;
+
+	if (other.inlineCount == mSpilled)
+	{
+		inlineCount = mSpilled;
+		return *this;
+	}
+	for (; inlineCount < other.inlineCount; inlineCount++)
+		AllocatorTraits::construct(allocator, slotAddress(inlineCount), *other.inlineAddress(inlineCount));
+
+	return *this;
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+SmallDeque<T, InlineN, BlockBytes, Allocator>& SmallDeque<T, InlineN, BlockBytes, Allocator>::operator=(SmallDeque&& other) noexcept(std::is_nothrow_move_constructible_v<T> && (std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value || std::allocator_traits<Allocator>::is_always_equal::value))
+{
+	if (this == &other)
+		return *this;
+
+	clear();
+	heap = std::move(other.heap);
+	if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value)
+		allocator = other.allocator;
+
+	if (other.inlineCount == mSpilled)
+	{
+		inlineCount = mSpilled;
+		other.inlineCount = 0;
+		return *this;
+	}
+	for (; inlineCount < other.inlineCount; inlineCount++)
+		AllocatorTraits::construct(allocator, slotAddress(inlineCount), std::move(*other.inlineAddress(inlineCount)));
+	other.destroyInline();
+
+	return *this;
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+T* SmallDeque<T, InlineN, BlockBytes, Allocator>::slotAddress(std::size_t slot)
+{
+	return std::launder(reinterpret_cast<T*>(storage)) + slot;
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+const T* SmallDeque<T, InlineN, BlockBytes, Allocator>::slotAddress(std::size_t slot) const
+{
+	return std::launder(reinterpret_cast<const T*>(storage)) + slot;
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+T* SmallDeque<T, InlineN, BlockBytes, Allocator>::inlineAddress(std::size_t index)
+{
+	std::size_t slot = head + index;  //head and index are both below InlineN,so one subtraction wraps the slot around
+	if (slot >= InlineN)
+		slot -= InlineN;
+	return slotAddress(slot);
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+const T* SmallDeque<T, InlineN, BlockBytes, Allocator>::inlineAddress(std::size_t index) const
+{
+	std::size_t slot = head + index;
+	if (slot >= InlineN)
+		slot -= InlineN;
+	return slotAddress(slot);
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+T* SmallDeque<T, InlineN, BlockBytes, Allocator>::elementAddress(std::size_t index)
+{
+	if (inlineCount == mSpilled)  //the non-const operator[] of the Deque clones a block that is shared with a copy before it hands out a writable element
+		return &heap[index];
+	return inlineAddress(index);
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+const T* SmallDeque<T, InlineN, BlockBytes, Allocator>::elementAddress(std::size_t index) const
+{
+	if (inlineCount == mSpilled)
+		return &heap[index];
+	return inlineAddress(index);
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+void SmallDeque<T, InlineN, BlockBytes, Allocator>::spill()
+{
+	//append allocates all the blocks before it constructs the first element,so an exception leaves the Deque empty.Elements whose move can throw are copied,so they stay inline in that case
+	if constexpr (std::is_nothrow_move_constructible_v<T>)
+		heap.append(std::make_move_iterator(begin()), std::make_move_iterator(end()));
+	else
+		heap.append(cbegin(), cend());
+	destroyInline();
+	inlineCount = mSpilled;
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+void SmallDeque<T, InlineN, BlockBytes, Allocator>::destroyInline()
+{
+	if constexpr (!std::is_trivially_destructible_v<T>)
+	{
+		for (std::size_t i = 0; i < inlineCount; i++)
+			AllocatorTraits::destroy(allocator, inlineAddress(i));
+	}
+
+	head = 0;
+	inlineCount = 0;
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+void SmallDeque<T, InlineN, BlockBytes, Allocator>::push_back(const T& value)
+{
+	emplace_back(value);
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+void SmallDeque<T, InlineN, BlockBytes, Allocator>::push_back(T&& value)
+{
+	emplace_back(std::move(value));
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+void SmallDeque<T, InlineN, BlockBytes, Allocator>::push_front(const T& value)
+{
+	emplace_front(value);
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+void SmallDeque<T, InlineN, BlockBytes, Allocator>::push_front(T&& value)
+{
+	emplace_front(std::move(value));
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+template<typename... Args>
+T& SmallDeque<T, InlineN, BlockBytes, Allocator>::emplace_back(Args&&... args)
+{
+	if (inlineCount < InlineN)
+	{
+		T* element = inlineAddress(inlineCount);
+		AllocatorTraits::construct(allocator, element, std::forward<Args>(args)...);
+		inlineCount++;
+		return *element;
+	}
+
+	if (inlineCount == InlineN)
+	{
+		T value(std::forward<Args>(args)...);  //the arguments may refer to an inline element,so the new element is made before the spill moves them
+		spill();
+		return heap.emplace_back(std::move(value));
+	}
+
+	return heap.emplace_back(std::forward<Args>(args)...);
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+template<typename... Args>
+T& SmallDeque<T, InlineN, BlockBytes, Allocator>::emplace_front(Args&&... args)
+{
+	if (inlineCount < InlineN)
+	{
+		std::size_t newHead = head == 0 ? InlineN - 1 : head - 1;
+		T* element = slotAddress(newHead);
+		AllocatorTraits::construct(allocator, element, std::forward<Args>(args)...);
+		head = newHead;
+		inlineCount++;
+		return *element;
+	}
+
+	if (inlineCount == InlineN)
+	{
+		T value(std::forward<Args>(args)...);
+		spill();
+		return heap.emplace_front(std::move(value));
+	}
+
+	return heap.emplace_front(std::forward<Args>(args)...);
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+void SmallDeque<T, InlineN, BlockBytes, Allocator>::pop_back()
+{
+	if (inlineCount - 1 < InlineN)  //an empty deque wraps around to the largest value
+	{
+		AllocatorTraits::destroy(allocator, inlineAddress(inlineCount - 1));
+		inlineCount--;
+		return;
+	}
+
+	if (inlineCount == mSpilled)
+	{
+		heap.pop_back();
+		if (heap.empty())  //the next pushes go inline again
+			inlineCount = 0;
+	}
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+void SmallDeque<T, InlineN, BlockBytes, Allocator>::pop_front()
+{
+	if (inlineCount - 1 < InlineN)
+	{
+		AllocatorTraits::destroy(allocator, slotAddress(head));
+		head = head + 1 == InlineN ? 0 : head + 1;
+		inlineCount--;
+		return;
+	}
+
+	if (inlineCount == mSpilled)
+	{
+		heap.pop_front();
+		if (heap.empty())
+			inlineCount = 0;
+	}
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+T& SmallDeque<T, InlineN, BlockBytes, Allocator>::front()
+{
+	if (inlineCount - 1 < InlineN)
+		return *slotAddress(head);
+	if (inlineCount == 0)
+		throw std::out_of_range("Deque is empty, cannot access front element.");
+
+	return heap.front();
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+const T& SmallDeque<T, InlineN, BlockBytes, Allocator>::front() const
+{
+	if (inlineCount - 1 < InlineN)
+		return *slotAddress(head);
+	if (inlineCount == 0)
+		throw std::out_of_range("Deque is empty, cannot access front element.");
+
+	return heap.front();
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+T& SmallDeque<T, InlineN, BlockBytes, Allocator>::back()
+{
+	if (inlineCount - 1 < InlineN)
+		return *inlineAddress(inlineCount - 1);
+	if (inlineCount == 0)
+		throw std::out_of_range("Deque is empty, cannot access back element.");
+
+	return heap.back();
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+const T& SmallDeque<T, InlineN, BlockBytes, Allocator>::back() const
+{
+	if (inlineCount - 1 < InlineN)
+		return *inlineAddress(inlineCount - 1);
+	if (inlineCount == 0)
+		throw std::out_of_range("Deque is empty, cannot access back element.");
+
+	return heap.back();
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+T& SmallDeque<T, InlineN, BlockBytes, Allocator>::operator[](std::size_t index)
+{
+	std::size_t count = size();
+	if (index >= count)
+	{
+		if (count == 0)  //either the deque is empty
+		{
+			throw std::out_of_range("Trying to access empty deque");
+		}
+		else  //or the index is out of range
+		{
+			clear();
+			throw std::out_of_range("Index out of range");
+		}
+	}
+
+	return *elementAddress(index);
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+const T& SmallDeque<T, InlineN, BlockBytes, Allocator>::operator[](std::size_t index) const
+{
+	std::size_t count = size();
+	if (index >= count)
+		throw std::out_of_range(count == 0 ? "Trying to access empty deque" : "Index out of range");
+
+	return *elementAddress(index);
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+bool SmallDeque<T, InlineN, BlockBytes, Allocator>::empty() const
+{
+	return inlineCount == 0;
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+bool SmallDeque<T, InlineN, BlockBytes, Allocator>::is_inline() const
+{
+	return inlineCount != mSpilled;
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+void SmallDeque<T, InlineN, BlockBytes, Allocator>::clear()
+{
+	if (inlineCount == mSpilled)
+	{
+		heap.clear();
+		inlineCount = 0;
+		return;
+	}
+
+	destroyInline();
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+std::size_t SmallDeque<T, InlineN, BlockBytes, Allocator>::size() const
+{
+	return inlineCount == mSpilled ? heap.size() : inlineCount;
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+Allocator SmallDeque<T, InlineN, BlockBytes, Allocator>::get_allocator() const
+{
+	return allocator;
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::Iterator SmallDeque<T, InlineN, BlockBytes, Allocator>::begin()
+{
+	return Iterator(this, 0);
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::Iterator SmallDeque<T, InlineN, BlockBytes, Allocator>::end()
+{
+	return Iterator(this, size());
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::ConstIterator SmallDeque<T, InlineN, BlockBytes, Allocator>::begin() const
+{
+	return ConstIterator(this, 0);
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::ConstIterator SmallDeque<T, InlineN, BlockBytes, Allocator>::end() const
+{
+	return ConstIterator(this, size());
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::ConstIterator SmallDeque<T, InlineN, BlockBytes, Allocator>::cbegin() const
+{
+	return begin();
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::ConstIterator SmallDeque<T, InlineN, BlockBytes, Allocator>::cend() const
+{
+	return end();
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::reverse_iterator SmallDeque<T, InlineN, BlockBytes, Allocator>::rbegin()
+{
+	return reverse_iterator(end());
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::reverse_iterator SmallDeque<T, InlineN, BlockBytes, Allocator>::rend()
+{
+	return reverse_iterator(begin());
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::const_reverse_iterator SmallDeque<T, InlineN, BlockBytes, Allocator>::rbegin() const
+{
+	return const_reverse_iterator(end());
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::const_reverse_iterator SmallDeque<T, InlineN, BlockBytes, Allocator>::rend() const
+{
+	return const_reverse_iterator(begin());
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::template BasicIterator<IsConst>::reference SmallDeque<T, InlineN, BlockBytes, Allocator>::BasicIterator<IsConst>::operator*() const
+{
+	return *deque->elementAddress(index);
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::template BasicIterator<IsConst>::pointer SmallDeque<T, InlineN, BlockBytes, Allocator>::BasicIterator<IsConst>::operator->() const
+{
+	return deque->elementAddress(index);
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::template BasicIterator<IsConst>::reference SmallDeque<T, InlineN, BlockBytes, Allocator>::BasicIterator<IsConst>::operator[](difference_type steps) const
+{
+	return *deque->elementAddress(index + steps);
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::template BasicIterator<IsConst>& SmallDeque<T, InlineN, BlockBytes, Allocator>::BasicIterator<IsConst>::operator++()
+{
+	++index;
+
+	return *this;
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::template BasicIterator<IsConst>& SmallDeque<T, InlineN, BlockBytes, Allocator>::BasicIterator<IsConst>::operator--()
+{
+	--index;
+
+	return *this;
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::template BasicIterator<IsConst> SmallDeque<T, InlineN, BlockBytes, Allocator>::BasicIterator<IsConst>::operator++(int)
+{
+	BasicIterator temp = *this;
+	++index;
+
+	return temp;
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::template BasicIterator<IsConst> SmallDeque<T, InlineN, BlockBytes, Allocator>::BasicIterator<IsConst>::operator--(int)
+{
+	BasicIterator temp = *this;
+	--index;
+
+	return temp;
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::template BasicIterator<IsConst>& SmallDeque<T, InlineN, BlockBytes, Allocator>::BasicIterator<IsConst>::operator+=(difference_type steps)
+{
+	index += steps;
+
+	return *this;
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::template BasicIterator<IsConst>& SmallDeque<T, InlineN, BlockBytes, Allocator>::BasicIterator<IsConst>::operator-=(difference_type steps)
+{
+	index -= steps;
+
+	return *this;
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::template BasicIterator<IsConst> SmallDeque<T, InlineN, BlockBytes, Allocator>::BasicIterator<IsConst>::operator+(difference_type steps) const
+{
+	return BasicIterator(deque, index + steps);
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::template BasicIterator<IsConst> SmallDeque<T, InlineN, BlockBytes, Allocator>::BasicIterator<IsConst>::operator-(difference_type steps) const
+{
+	return BasicIterator(deque, index - steps);
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+template<bool OtherIsConst>
+typename SmallDeque<T, InlineN, BlockBytes, Allocator>::template BasicIterator<IsConst>::difference_type SmallDeque<T, InlineN, BlockBytes, Allocator>::BasicIterator<IsConst>::operator-(const BasicIterator<OtherIsConst>& other) const
+{
+	return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+template<bool OtherIsConst>
+bool SmallDeque<T, InlineN, BlockBytes, Allocator>::BasicIterator<IsConst>::operator==(const BasicIterator<OtherIsConst>& other) const
+{
+	return index == other.index;
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+template<bool OtherIsConst>
+bool SmallDeque<T, InlineN, BlockBytes, Allocator>::BasicIterator<IsConst>::operator!=(const BasicIterator<OtherIsConst>& other) const
+{
+	return index != other.index;
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+template<bool OtherIsConst>
+bool SmallDeque<T, InlineN, BlockBytes, Allocator>::BasicIterator<IsConst>::operator<(const BasicIterator<OtherIsConst>& other) const
+{
+	return index < other.index;
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+template<bool OtherIsConst>
+bool SmallDeque<T, InlineN, BlockBytes, Allocator>::BasicIterator<IsConst>::operator>(const BasicIterator<OtherIsConst>& other) const
+{
+	return index > other.index;
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+template<bool OtherIsConst>
+bool SmallDeque<T, InlineN, BlockBytes, Allocator>::BasicIterator<IsConst>::operator<=(const BasicIterator<OtherIsConst>& other) const
+{
+	return index <= other.index;
+}
+
+template<typename T, std::size_t InlineN, std::size_t BlockBytes, typename Allocator>
+template<bool IsConst>
+template<bool OtherIsConst>
+bool SmallDeque<T, InlineN, BlockBytes, Allocator>::BasicIterator<IsConst>::operator>=(const BasicIterator<OtherIsConst>& other) const
+{
+	return index >= other.index;
+}
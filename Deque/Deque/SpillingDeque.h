@@ -0,0 +1,467 @@
+#pragma once
+#include"Deque.h"
+#include<algorithm>
+#include<cerrno>
+#include<cstddef>
+#include<filesystem>
+#include<iterator>
+#include<memory>
+#include<new>
+#include<stdexcept>
+#include<string>
+#include<system_error>
+#include<type_traits>
+#include<utility>
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<unistd.h>
+
+//a FIFO queue that can grow past the memory of the machine.The elements are stored in segment files of a fixed size that are memory-mapped while they are used:the segments at the front that pop_front reads and the segments at the back that push_back writes stay mapped,the ones in between are unmapped,so the kernel writes them out and they don't count towards the resident memory.When the front moves on to the next segment,the segment that enters the front window is mapped again and the kernel is asked to read it ahead of the consumer.Needs POSIX mmap
+template<typename T>
+class SpillingDeque
+{
+	static_assert(std::is_trivially_copyable_v<T>, "SpillingDeque stores its elements as bytes in files,so T must be trivially copyable");
+
+	//a segment file is named after its id.data is nullptr while the segment is spilled
+	struct Segment
+	{
+		std::size_t id;
+		T* data;
+	};
+
+	std::filesystem::path directory;  //a directory of its own that is created inside the configured one,so several deques can spill to the same place
+	std::size_t residentSegments;  //the number of segments that stay mapped at each end
+	std::size_t segmentBytes;
+	std::size_t segmentSize;  //the number of elements in a segment
+
+	Deque<Segment> segments;  //ordered from the front of the deque to the back
+	std::size_t firstIndex, lastIndex;  //the index of the first element in the first segment and the index after the last element in the last segment
+	std::size_t count;
+	std::size_t mappedSegments;
+	std::size_t nextSegmentId;
+
+	//a consumed segment is kept mapped and reused by the next push_back that needs a segment,so a queue that stays around the same size doesn't create and delete files
+	Segment spareSegment;
+	bool hasSpareSegment;
+
+	std::filesystem::path segmentPath(std::size_t id) const;
+
+	T* mapFile(std::size_t id, bool create, bool writable) const;
+
+	void unmapFile(const T* data) const;
+
+	void mapSegment(Segment& segment);
+
+	void spillSegment(Segment& segment);
+
+	void deleteSegment(Segment& segment);
+
+	Segment newSegment();
+
+	void releaseSegments();
+
+public:
+	//iterates from the front to the back.A spilled segment is mapped read-only while an iterator is in it.Any push_back or pop_front invalidates the iterators
+	class ConstIterator
+	{
+		friend class SpillingDeque;
+
+		const SpillingDeque* deque;
+		std::size_t segment;
+		std::size_t index;
+		const T* data;
+		std::shared_ptr<const T> mapping;  //holds the mapping of a spilled segment,it is shared by the copies of the iterator
+
+		ConstIterator(const SpillingDeque* deque, std::size_t segment, std::size_t index);
+
+		void enterSegment();
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const T*;
+		using reference = const T&;
+
+		ConstIterator() : deque(nullptr), segment(0), index(0), data(nullptr) {}
+
+		reference operator*() const { return data[index]; }
+		pointer operator->() const { return data + index; }
+		ConstIterator& operator++();
+		ConstIterator operator++(int);
+		bool operator==(const ConstIterator& other) const { return segment == other.segment && index == other.index; }
+		bool operator!=(const ConstIterator& other) const { return !(*this == other); }
+	};
+
+	using value_type = T;
+	using size_type = std::size_t;
+	using const_iterator = ConstIterator;
+
+	//residentSegments is the number of segments kept mapped at each end and is at least 1,with 2 or more the consumer finds the next segment already read in.segmentBytes is rounded up to whole pages
+	explicit SpillingDeque(const std::filesystem::path& directory, std::size_t residentSegments = 2, std::size_t segmentBytes = 1 << 20);
+
+	SpillingDeque(const SpillingDeque&) = delete;
+
+	SpillingDeque& operator=(const SpillingDeque&) = delete;
+
+	~SpillingDeque();
+
+	void push_back(const T& value);
+
+	template<typename... Args>
+	T& emplace_back(Args&&... args);
+
+	void pop_front();
+
+	T& front();
+
+	const T& front() const;
+
+	T& back();
+
+	const T& back() const;
+
+	bool empty() const;
+
+	std::size_t size() const;
+
+	void clear();
+
+	ConstIterator begin() const;
+
+	ConstIterator end() const;
+
+	ConstIterator cbegin() const;
+
+	ConstIterator cend() const;
+
+	//the number of segments that are mapped and the number that only exist on disk
+	std::size_t resident_segments() const;
+
+	std::size_t spilled_segments() const;
+};
+
+template<typename T>
+SpillingDeque<T>::SpillingDeque(const std::filesystem::path& directory, std::size_t residentSegments, std::size_t segmentBytes) : residentSegments(std::max<std::size_t>(residentSegments, 1)), segmentBytes(0), segmentSize(0), firstIndex(0), lastIndex(0), count(0), mappedSegments(0), nextSegmentId(0), spareSegment{ 0, nullptr }, hasSpareSegment(false)
+{
+	std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+	std::size_t bytes = std::max(segmentBytes, sizeof(T));
+	this->segmentBytes = (bytes + pageSize - 1) / pageSize * pageSize;
+	segmentSize = this->segmentBytes / sizeof(T);
+
+	std::string pattern = (directory / "deque-XXXXXX").string();
+	if (mkdtemp(pattern.data()) == nullptr)
+		throw std::system_error(errno, std::generic_category(), "SpillingDeque could not create a directory in " + directory.string());
+	this->directory = pattern;
+}
+
+template<typename T>
+SpillingDeque<T>::~SpillingDeque()
+{
+	releaseSegments();
+	std::error_code error;
+	std::filesystem::remove_all(directory, error);  //a destructor can't throw,a directory that can't be removed is left behind
+}
+
+template<typename T>
+std::filesystem::path SpillingDeque<T>::segmentPath(std::size_t id) const
+{
+	return directory / ("segment-" + std::to_string(id));
+}
+
+template<typename T>
+T* SpillingDeque<T>::mapFile(std::size_t id, bool create, bool writable) const
+{
+	std::string path = segmentPath(id).string();
+	int file = open(path.c_str(), (writable ? O_RDWR : O_RDONLY) | (create ? O_CREAT | O_TRUNC : 0), 0600);
+	if (file < 0)
+		throw std::system_error(errno, std::generic_category(), "SpillingDeque could not open " + path);
+
+	//the disk space is allocated up front,so a full disk is reported here instead of as a signal when a page of the mapping is written
+	if (create)
+	{
+		int error = posix_fallocate(file, 0, static_cast<off_t>(segmentBytes));
+		if (error != 0)
+		{
+			close(file);
+			throw std::system_error(error, std::generic_category(), "SpillingDeque could not allocate " + path);
+		}
+	}
+
+	void* data = mmap(nullptr, segmentBytes, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, file, 0);
+	int error = errno;
+	close(file);  //the mapping keeps the file open,so a deque with many spilled segments doesn't run out of file descriptors
+	if (data == MAP_FAILED)
+		throw std::system_error(error, std::generic_category(), "SpillingDeque could not map " + path);
+
+	return static_cast<T*>(data);
+}
+
+template<typename T>
+void SpillingDeque<T>::unmapFile(const T* data) const
+{
+	munmap(const_cast<T*>(data), segmentBytes);
+}
+
+template<typename T>
+void SpillingDeque<T>::mapSegment(Segment& segment)
+{
+	if (segment.data != nullptr)
+		return;
+
+	segment.data = mapFile(segment.id, false, true);
+	madvise(segment.data, segmentBytes, MADV_WILLNEED);  //starts reading the segment in,it is popped only after the segments in front of it
+	mappedSegments++;
+}
+
+template<typename T>
+void SpillingDeque<T>::spillSegment(Segment& segment)
+{
+	if (segment.data == nullptr)
+		return;
+
+	unmapFile(segment.data);  //the written pages stay in the page cache until the kernel writes them to the file
+	segment.data = nullptr;
+	mappedSegments--;
+}
+
+template<typename T>
+void SpillingDeque<T>::deleteSegment(Segment& segment)
+{
+	spillSegment(segment);
+	std::error_code error;
+	std::filesystem::remove(segmentPath(segment.id), error);
+}
+
+template<typename T>
+typename SpillingDeque<T>::Segment SpillingDeque<T>::newSegment()
+{
+	if (hasSpareSegment)
+	{
+		hasSpareSegment = false;
+		return spareSegment;
+	}
+
+	Segment segment{ nextSegmentId, mapFile(nextSegmentId, true, true) };
+	nextSegmentId++;
+	mappedSegments++;
+	return segment;
+}
+
+template<typename T>
+void SpillingDeque<T>::releaseSegments()
+{
+	for (Segment& segment : segments)
+		deleteSegment(segment);
+	segments.clear();
+	if (hasSpareSegment)
+	{
+		deleteSegment(spareSegment);
+		hasSpareSegment = false;
+	}
+	firstIndex = 0;
+	lastIndex = 0;
+	count = 0;
+}
+
+template<typename T>
+void SpillingDeque<T>::push_back(const T& value)
+{
+	emplace_back(value);
+}
+
+template<typename T>
+template<typename... Args>
+T& SpillingDeque<T>::emplace_back(Args&&... args)
+{
+	if (segments.empty() || lastIndex == segmentSize)  //the last segment is full,the element goes to a new segment
+	{
+		segments.push_back(newSegment());
+		lastIndex = 0;
+
+		//the segment that just left the back window is spilled,unless it is still in the front window
+		std::size_t segmentCount = segments.size();
+		if (segmentCount > 2 * residentSegments)
+			spillSegment(segments[segmentCount - residentSegments - 1]);
+	}
+
+	T* element = ::new (static_cast<void*>(segments.back().data + lastIndex)) T(std::forward<Args>(args)...);
+	lastIndex++;
+	count++;
+	return *element;
+}
+
+template<typename T>
+void SpillingDeque<T>::pop_front()
+{
+	if (empty())
+		return;
+
+	if (count == 1)  //the only element is popped,its segment is reused from the start
+	{
+		firstIndex = 0;
+		lastIndex = 0;
+		count = 0;
+		return;
+	}
+
+	if (firstIndex + 1 < segmentSize)
+	{
+		firstIndex++;
+		count--;
+		return;
+	}
+
+	//the first segment is consumed.The segment that enters the front window is mapped and read ahead before anything is changed,so if that fails the deque is unchanged
+	if (segments.size() > residentSegments)
+		mapSegment(segments[residentSegments]);
+
+	Segment consumed = segments.front();
+	segments.pop_front();
+	firstIndex = 0;
+	count--;
+	if (!hasSpareSegment)
+	{
+		spareSegment = consumed;
+		hasSpareSegment = true;
+	}
+	else
+	{
+		deleteSegment(consumed);
+	}
+}
+
+template<typename T>
+T& SpillingDeque<T>::front()
+{
+	if (empty())
+		throw std::out_of_range("Deque is empty, cannot access front element.");
+	return segments.front().data[firstIndex];
+}
+
+template<typename T>
+const T& SpillingDeque<T>::front() const
+{
+	if (empty())
+		throw std::out_of_range("Deque is empty, cannot access front element.");
+	return segments.front().data[firstIndex];
+}
+
+template<typename T>
+T& SpillingDeque<T>::back()
+{
+	if (empty())
+		throw std::out_of_range("Deque is empty, cannot access back element.");
+	return segments.back().data[lastIndex - 1];
+}
+
+template<typename T>
+const T& SpillingDeque<T>::back() const
+{
+	if (empty())
+		throw std::out_of_range("Deque is empty, cannot access back element.");
+	return segments.back().data[lastIndex - 1];
+}
+
+template<typename T>
+bool SpillingDeque<T>::empty() const
+{
+	return count == 0;
+}
+
+template<typename T>
+std::size_t SpillingDeque<T>::size() const
+{
+	return count;
+}
+
+template<typename T>
+void SpillingDeque<T>::clear()
+{
+	releaseSegments();
+}
+
+template<typename T>
+std::size_t SpillingDeque<T>::resident_segments() const
+{
+	return mappedSegments;
+}
+
+template<typename T>
+std::size_t SpillingDeque<T>::spilled_segments() const
+{
+	return segments.size() + (hasSpareSegment ? 1 : 0) - mappedSegments;
+}
+
+template<typename T>
+typename SpillingDeque<T>::ConstIterator SpillingDeque<T>::begin() const
+{
+	if (empty())
+		return end();
+	return ConstIterator(this, 0, firstIndex);
+}
+
+template<typename T>
+typename SpillingDeque<T>::ConstIterator SpillingDeque<T>::end() const
+{
+	//the end is the start of the segment after the last one,so an iterator that runs off a full last segment compares equal to it
+	if (empty())
+		return ConstIterator(this, 0, 0);
+	return lastIndex == segmentSize ? ConstIterator(this, segments.size(), 0) : ConstIterator(this, segments.size() - 1, lastIndex);
+}
+
+template<typename T>
+typename SpillingDeque<T>::ConstIterator SpillingDeque<T>::cbegin() const
+{
+	return begin();
+}
+
+template<typename T>
+typename SpillingDeque<T>::ConstIterator SpillingDeque<T>::cend() const
+{
+	return end();
+}
+
+template<typename T>
+SpillingDeque<T>::ConstIterator::ConstIterator(const SpillingDeque* deque, std::size_t segment, std::size_t index) : deque(deque), segment(segment), index(index), data(nullptr)
+{
+	enterSegment();
+}
+
+template<typename T>
+void SpillingDeque<T>::ConstIterator::enterSegment()
+{
+	mapping.reset();
+	data = nullptr;
+	if (segment >= deque->segments.size())
+		return;
+
+	data = deque->segments[segment].data;
+	if (data == nullptr)  //a spilled segment is mapped read-only for as long as an iterator is in it,the deque itself is not changed
+	{
+		const SpillingDeque* owner = deque;
+		data = owner->mapFile(owner->segments[segment].id, false, false);
+		mapping = std::shared_ptr<const T>(data, [owner](const T* mapped) { owner->unmapFile(mapped); });
+	}
+}
+
+template<typename T>
+typename SpillingDeque<T>::ConstIterator& SpillingDeque<T>::ConstIterator::operator++()
+{
+	index++;
+	if (index == deque->segmentSize)
+	{
+		segment++;
+		index = 0;
+		enterSegment();
+	}
+	return *this;
+}
+
+template<typename T>
+typename SpillingDeque<T>::ConstIterator SpillingDeque<T>::ConstIterator::operator++(int)
+{
+	ConstIterator copy = *this;
+	++*this;
+	return copy;
+}
@@ -0,0 +1,329 @@
+#pragma once
+#include<algorithm>
+#include<atomic>
+#include<bit>
+#include<cstddef>
+#include<cstdint>
+#include<memory>
+#include<type_traits>
+
+//a Chase-Lev work-stealing deque.The owner thread pushes and pops at the back without locks,any number of thief threads take elements from the front with a compare-and-swap on the front index.
+//The storage is a ring of blocks:element i lives in block (i / blockSize) mod blockCount.When the ring is full a ring with twice as many blocks is made that relinks the old blocks,so growing doesn't copy the elements.
+//Thieves can still be reading the old ring while the owner uses the new one,so the old rings are kept until the deque is destroyed.The elements are stored as std::atomic<T> because a thief can read a slot while the owner writes it,so T has to be trivially copyable,typically a pointer or an index of a task
+template<typename T, std::size_t BlockBytes = 512, typename Allocator = std::allocator<T>>
+class WorkStealingDeque
+{
+	static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque needs a trivially copyable T");
+
+	//the block size is rounded down to a power of two so the position of an element is found with masks
+	static constexpr std::size_t mBlockSize = std::bit_floor(sizeof(T) < BlockBytes ? BlockBytes / sizeof(T) : std::size_t(1));
+	static constexpr std::size_t mBlockShift = std::countr_zero(mBlockSize);
+	static constexpr std::size_t mInitialBlockCount = 4;
+	static constexpr std::size_t mCacheLineSize = 64;
+
+	struct Block
+	{
+		std::atomic<T> slots[mBlockSize];
+	};
+
+	//blockCount is a power of two.orphanBlock is a block of this ring that the next ring doesn't use,it is released with the ring
+	struct Ring
+	{
+		std::size_t blockCount;
+		Block** blocks;
+		Block* orphanBlock;
+		Ring* retiredNext;
+
+		std::atomic<T>& slot(std::int64_t index) const
+		{
+			std::size_t position = static_cast<std::size_t>(index);
+			return blocks[(position >> mBlockShift) & (blockCount - 1)]->slots[position & (mBlockSize - 1)];
+		}
+	};
+
+	using BlockAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Block>;
+	using RingAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Ring>;
+	using DirectoryAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Block*>;
+	using BlockAllocatorTraits = std::allocator_traits<BlockAllocator>;
+	using RingAllocatorTraits = std::allocator_traits<RingAllocator>;
+	using DirectoryAllocatorTraits = std::allocator_traits<DirectoryAllocator>;
+
+	Allocator allocator;
+
+	//the front index is written by the thieves and the owner,the back index only by the owner.They are on separate cache lines so pushes don't slow down the thieves
+	alignas(mCacheLineSize) std::atomic<std::int64_t> top;
+	alignas(mCacheLineSize) std::atomic<std::int64_t> bottom;
+	std::atomic<Ring*> ring;
+	Ring* retiredRings;  //only touched by the owner
+
+	Block* allocateBlock();
+
+	void deallocateBlock(Block* block);
+
+	Ring* allocateRing(std::size_t blockCount);
+
+	void deallocateRing(Ring* oldRing);
+
+	Ring* grow(Ring* oldRing, std::int64_t front, std::int64_t back);
+
+public:
+	using value_type = T;
+	using allocator_type = Allocator;
+
+	WorkStealingDeque();
+
+	explicit WorkStealingDeque(const Allocator& allocator);
+
+	WorkStealingDeque(const WorkStealingDeque&) = delete;
+
+	WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+	~WorkStealingDeque();
+
+	//owner thread only
+	void push_back(const T& value);
+
+	//owner thread only.Moves the last element into value and returns true,or returns false if the deque is empty
+	bool try_pop_back(T& value);
+
+	//any thread.Moves the first element into value and returns true,or returns false if the deque is empty or another thread took the element first
+	bool try_steal(T& value);
+
+	//any thread,the result may be out of date as soon as it is returned
+	bool empty() const;
+
+	std::size_t size() const;
+
+	Allocator get_allocator() const;
+};
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+WorkStealingDeque<T, BlockBytes, Allocator>::WorkStealingDeque() : WorkStealingDeque(Allocator()) {}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+WorkStealingDeque<T, BlockBytes, Allocator>::WorkStealingDeque(const Allocator& allocator) : allocator(allocator), top(0), bottom(0), ring(nullptr), retiredRings(nullptr)
+{
+	Ring* initialRing = allocateRing(mInitialBlockCount);
+	std::size_t i = 0;
+	try
+	{
+		for (; i < mInitialBlockCount; i++)
+			initialRing->blocks[i] = allocateBlock();
+	}
+	catch (...)
+	{
+		while (i > 0)
+			deallocateBlock(initialRing->blocks[--i]);
+		deallocateRing(initialRing);
+		throw;
+	}
+	ring.store(initialRing, std::memory_order_relaxed);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+WorkStealingDeque<T, BlockBytes, Allocator>::~WorkStealingDeque()
+{
+	Ring* currentRing = ring.load(std::memory_order_relaxed);
+	for (std::size_t i = 0; i < currentRing->blockCount; i++)
+		deallocateBlock(currentRing->blocks[i]);
+	deallocateRing(currentRing);
+
+	while (retiredRings != nullptr)  //the blocks of a retired ring belong to the rings that replaced it,apart from its orphan block
+	{
+		Ring* next = retiredRings->retiredNext;
+		if (retiredRings->orphanBlock != nullptr)
+			deallocateBlock(retiredRings->orphanBlock);
+		deallocateRing(retiredRings);
+		retiredRings = next;
+	}
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+typename WorkStealingDeque<T, BlockBytes, Allocator>::Block* WorkStealingDeque<T, BlockBytes, Allocator>::allocateBlock()
+{
+	BlockAllocator blockAllocator(allocator);
+	Block* block = BlockAllocatorTraits::allocate(blockAllocator, 1);
+	return new (block) Block();
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+void WorkStealingDeque<T, BlockBytes, Allocator>::deallocateBlock(Block* block)
+{
+	block->~Block();
+	BlockAllocator blockAllocator(allocator);
+	BlockAllocatorTraits::deallocate(blockAllocator, block, 1);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+typename WorkStealingDeque<T, BlockBytes, Allocator>::Ring* WorkStealingDeque<T, BlockBytes, Allocator>::allocateRing(std::size_t blockCount)
+{
+	RingAllocator ringAllocator(allocator);
+	DirectoryAllocator directoryAllocator(allocator);
+	Ring* newRing = RingAllocatorTraits::allocate(ringAllocator, 1);
+	try
+	{
+		newRing->blocks = DirectoryAllocatorTraits::allocate(directoryAllocator, blockCount);
+	}
+	catch (...)
+	{
+		RingAllocatorTraits::deallocate(ringAllocator, newRing, 1);
+		throw;
+	}
+	newRing->blockCount = blockCount;
+	newRing->orphanBlock = nullptr;
+	newRing->retiredNext = nullptr;
+	return newRing;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+void WorkStealingDeque<T, BlockBytes, Allocator>::deallocateRing(Ring* oldRing)
+{
+	RingAllocator ringAllocator(allocator);
+	DirectoryAllocator directoryAllocator(allocator);
+	DirectoryAllocatorTraits::deallocate(directoryAllocator, oldRing->blocks, oldRing->blockCount);
+	RingAllocatorTraits::deallocate(ringAllocator, oldRing, 1);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+typename WorkStealingDeque<T, BlockBytes, Allocator>::Ring* WorkStealingDeque<T, BlockBytes, Allocator>::grow(Ring* oldRing, std::int64_t front, std::int64_t back)
+{
+	std::size_t oldBlockCount = oldRing->blockCount;
+	std::size_t newBlockCount = oldBlockCount * 2;
+	Ring* newRing = allocateRing(newBlockCount);
+	std::fill(newRing->blocks, newRing->blocks + newBlockCount, nullptr);
+
+	std::size_t firstBlock = static_cast<std::size_t>(front) >> mBlockShift;
+	std::size_t lastBlock = static_cast<std::size_t>(back - 1) >> mBlockShift;
+	bool frontAndBackShareABlock = lastBlock - firstBlock == oldBlockCount;  //the ring is full and the front isn't at the start of a block,so the first and the last block are the same physical block
+
+	try
+	{
+		for (std::size_t blockNumber = firstBlock; blockNumber <= lastBlock; blockNumber++)
+		{
+			Block* oldBlock = oldRing->blocks[blockNumber & (oldBlockCount - 1)];
+			Block*& newSlot = newRing->blocks[blockNumber & (newBlockCount - 1)];
+			if (!frontAndBackShareABlock)
+			{
+				newSlot = oldBlock;  //relinked,the elements stay where they are
+			}
+			else  //the shared block would be in two places of the new ring,so both of its halves are copied to new blocks and the old one is left to the thieves that still read the old ring
+			{
+				if (blockNumber != firstBlock && blockNumber != lastBlock)
+				{
+					newSlot = oldBlock;
+					continue;
+				}
+				newSlot = allocateBlock();
+				for (std::size_t i = 0; i < mBlockSize; i++)
+					newSlot->slots[i].store(oldBlock->slots[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+			}
+		}
+		for (std::size_t i = 0; i < newBlockCount; i++)
+		{
+			if (newRing->blocks[i] == nullptr)
+				newRing->blocks[i] = allocateBlock();
+		}
+	}
+	catch (...)  //only the blocks that were allocated for the new ring are released,the relinked ones still belong to the old ring
+	{
+		for (std::size_t blockNumber = firstBlock; blockNumber <= lastBlock; blockNumber++)
+		{
+			if (!frontAndBackShareABlock || (blockNumber != firstBlock && blockNumber != lastBlock))
+				newRing->blocks[blockNumber & (newBlockCount - 1)] = nullptr;
+		}
+		for (std::size_t i = 0; i < newBlockCount; i++)
+		{
+			if (newRing->blocks[i] != nullptr)
+				deallocateBlock(newRing->blocks[i]);
+		}
+		deallocateRing(newRing);
+		throw;
+	}
+
+	if (frontAndBackShareABlock)
+		oldRing->orphanBlock = oldRing->blocks[firstBlock & (oldBlockCount - 1)];
+	oldRing->retiredNext = retiredRings;
+	retiredRings = oldRing;
+	return newRing;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+void WorkStealingDeque<T, BlockBytes, Allocator>::push_back(const T& value)
+{
+	std::int64_t back = bottom.load(std::memory_order_relaxed);
+	std::int64_t front = top.load(std::memory_order_acquire);
+	Ring* currentRing = ring.load(std::memory_order_relaxed);
+	if (back - front >= static_cast<std::int64_t>(currentRing->blockCount * mBlockSize))
+	{
+		currentRing = grow(currentRing, front, back);
+		ring.store(currentRing, std::memory_order_release);
+	}
+
+	currentRing->slot(back).store(value, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);  //the element is visible before the new back index
+	bottom.store(back + 1, std::memory_order_relaxed);
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+bool WorkStealingDeque<T, BlockBytes, Allocator>::try_pop_back(T& value)
+{
+	std::int64_t back = bottom.load(std::memory_order_relaxed) - 1;
+	Ring* currentRing = ring.load(std::memory_order_relaxed);
+	bottom.store(back, std::memory_order_relaxed);  //the element is reserved before the front index is read,the full fence orders the two against the thieves
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	std::int64_t front = top.load(std::memory_order_relaxed);
+
+	if (front > back)  //the deque was empty
+	{
+		bottom.store(back + 1, std::memory_order_relaxed);
+		return false;
+	}
+
+	value = currentRing->slot(back).load(std::memory_order_relaxed);
+	if (front == back)  //this is the last element,the owner races with the thieves for it on the front index
+	{
+		bool won = top.compare_exchange_strong(front, front + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		bottom.store(back + 1, std::memory_order_relaxed);
+		return won;
+	}
+
+	return true;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+bool WorkStealingDeque<T, BlockBytes, Allocator>::try_steal(T& value)
+{
+	std::int64_t front = top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	std::int64_t back = bottom.load(std::memory_order_acquire);
+	if (front >= back)
+		return false;
+
+	Ring* currentRing = ring.load(std::memory_order_acquire);
+	T element = currentRing->slot(front).load(std::memory_order_relaxed);
+	if (!top.compare_exchange_strong(front, front + 1, std::memory_order_seq_cst, std::memory_order_relaxed))  //another thief or the owner took the element
+		return false;
+
+	value = element;
+	return true;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+bool WorkStealingDeque<T, BlockBytes, Allocator>::empty() const
+{
+	return size() == 0;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+std::size_t WorkStealingDeque<T, BlockBytes, Allocator>::size() const
+{
+	std::int64_t back = bottom.load(std::memory_order_acquire);
+	std::int64_t front = top.load(std::memory_order_acquire);
+	return back > front ? static_cast<std::size_t>(back - front) : 0;
+}
+
+template<typename T, std::size_t BlockBytes, typename Allocator>
+Allocator WorkStealingDeque<T, BlockBytes, Allocator>::get_allocator() const
+{
+	return allocator;
+}